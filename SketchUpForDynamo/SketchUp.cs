@@ -121,6 +121,83 @@ public static bool ReformatModel(string filepath, string version, string newfile
             };
         }
 
+        /// <summary>
+        /// Load SketchUp Model Meshes by Path.
+        /// This node merges all faces of the model, including groups and instances,
+        /// into one mesh per layer or per material in world coordinates.
+        /// Use this instead of Load Model if you only need meshes of large models.
+        /// </summary>
+        /// <param name="path">Path to SketchUp file</param>
+        /// <param name="byMaterial">Merge faces by material instead of by layer</param>
+        [MultiReturn(new[] { "Meshes", "Names", "Materials" })]
+        public static Dictionary<string, object> LoadModelMeshes(string path, bool byMaterial = false)
+        {
+            List<Autodesk.DesignScript.Geometry.Mesh> meshes = new List<Autodesk.DesignScript.Geometry.Mesh>();
+            List<string> names = new List<string>();
+            List<Material> mats = new List<Material>();
+
+            SketchUpNET.SketchUp skp = new SketchUpNET.SketchUp();
+            if (skp.LoadMeshBatches(path, byMaterial ? MeshBatchGrouping.Material : MeshBatchGrouping.Layer))
+            {
+                foreach (MeshBatch batch in skp.MeshBatches)
+                {
+                    meshes.Add(batch.ToDSGeo());
+                    names.Add(batch.Name);
+                    mats.Add(batch.Material != null ? new Material(batch.Material) : null);
+                }
+            }
+
+            return new Dictionary<string, object>
+            {
+                { "Meshes", meshes },
+                { "Names", names },
+                { "Materials", mats }
+            };
+        }
+
+        /// <summary>
+        /// Load SketchUp Model Sections by Path.
+        /// This node cuts all faces of the model with horizontal planes
+        /// and returns the section contours per layer and material.
+        /// </summary>
+        /// <param name="path">Path to SketchUp file</param>
+        /// <param name="from">Lowest elevation</param>
+        /// <param name="to">Highest elevation</param>
+        /// <param name="step">Distance between planes</param>
+        [MultiReturn(new[] { "Contours", "Layers", "Elevations" })]
+        public static Dictionary<string, object> LoadModelSections(string path, double from, double to, double step = 0.5)
+        {
+            List<Autodesk.DesignScript.Geometry.PolyCurve> contours = new List<Autodesk.DesignScript.Geometry.PolyCurve>();
+            List<string> layers = new List<string>();
+            List<double> elevations = new List<double>();
+
+            SketchUpNET.SketchUp skp = new SketchUpNET.SketchUp();
+            double[] planes = SectionContour.HorizontalPlanes(from, to, step);
+            if (skp.LoadSections(path, planes))
+            {
+                foreach (SectionContour contour in skp.Sections)
+                {
+                    double[] p = contour.Points;
+                    if (p.Length < 6) continue;
+
+                    List<Autodesk.DesignScript.Geometry.Point> points = new List<Autodesk.DesignScript.Geometry.Point>();
+                    for (int i = 0; i < p.Length; i += 3)
+                        points.Add(Autodesk.DesignScript.Geometry.Point.ByCoordinates(p[i], p[i + 1], p[i + 2]));
+
+                    contours.Add(Autodesk.DesignScript.Geometry.PolyCurve.ByPoints(points, contour.IsClosed));
+                    layers.Add(contour.Layer);
+                    elevations.Add(-planes[4 * contour.Plane + 3]);
+                }
+            }
+
+            return new Dictionary<string, object>
+            {
+                { "Contours", contours },
+                { "Layers", layers },
+                { "Elevations", elevations }
+            };
+        }
+
         /// <summary>
         /// Load SketchUp Model by Path and Layername. 
         /// This node loads only contents of the specified layer into Dynamo.
@@ -356,6 +433,32 @@ public static void WriteModel(string path, List<Autodesk.DesignScript.Geometry.S
 
         }
 
+        /// <summary>
+        /// Triangulate Surfaces.
+        /// This node triangulates surfaces natively from their perimeter,
+        /// use it to preview surfaces and to check them before writing a model.
+        /// </summary>
+        /// <param name="surfaces">Surface Geometries</param>
+        [MultiReturn(new[] { "Meshes", "Valid" })]
+        public static Dictionary<string, object> TriangulateSurfaces(List<Autodesk.DesignScript.Geometry.Surface> surfaces)
+        {
+            List<Autodesk.DesignScript.Geometry.Mesh> meshes = new List<Autodesk.DesignScript.Geometry.Mesh>();
+            List<bool> valid = new List<bool>();
+
+            foreach (Autodesk.DesignScript.Geometry.Surface surface in surfaces)
+            {
+                SketchUpNET.Mesh mesh = surface.ToSKPGeo().Triangulate();
+                valid.Add(mesh != null);
+                meshes.Add(mesh != null ? mesh.ToDSGeo() : null);
+            }
+
+            return new Dictionary<string, object>
+            {
+                { "Meshes", meshes },
+                { "Valid", valid }
+            };
+        }
+
     }
 
     [IsVisibleInDynamoLibrary(false)]
@@ -453,6 +556,22 @@ public static Autodesk.DesignScript.Geometry.Mesh ToDSGeo(this SketchUpNET.Mesh
         }
 
 
+        [IsVisibleInDynamoLibrary(false)]
+        public static Autodesk.DesignScript.Geometry.Mesh ToDSGeo(this SketchUpNET.MeshBatch batch)
+        {
+            double[] p = batch.Positions;
+            List<Autodesk.DesignScript.Geometry.Point> points = new List<Autodesk.DesignScript.Geometry.Point>(batch.VertexCount);
+            for (int i = 0; i < p.Length; i += 3)
+                points.Add(Autodesk.DesignScript.Geometry.Point.ByCoordinates(p[i], p[i + 1], p[i + 2]));
+
+            int[] f = batch.Indices;
+            List<Autodesk.DesignScript.Geometry.IndexGroup> faces = new List<Autodesk.DesignScript.Geometry.IndexGroup>(batch.TriangleCount);
+            for (int i = 0; i < f.Length; i += 3)
+                faces.Add(Autodesk.DesignScript.Geometry.IndexGroup.ByIndices((uint)f[i], (uint)f[i + 1], (uint)f[i + 2]));
+
+            return Autodesk.DesignScript.Geometry.Mesh.ByPointsFaceIndices(points, faces);
+        }
+
         [IsVisibleInDynamoLibrary(false)]
         public static Autodesk.DesignScript.Geometry.Surface ToDSGeo(this SketchUpNET.Surface v, Transform t = null)
         {
@@ -195,7 +195,7 @@ protected override void RegisterOutputParams(GH_Component.GH_OutputParamManager
             pManager.AddTextParameter("Parent Name", "PN", "Parent Name", GH_ParamAccess.item);
             pManager.AddBrepParameter("Inner", "I", "Inner", GH_ParamAccess.list);
             pManager.AddCurveParameter("Curves", "C", "Curves", GH_ParamAccess.list);
-            pManager.AddCurveParameter("Meshes", "M", "Meshes", GH_ParamAccess.list);
+            pManager.AddMeshParameter("Meshes", "M", "Meshes", GH_ParamAccess.list);
         }
 
         protected override void SolveInstance(IGH_DataAccess DA)
@@ -223,13 +223,12 @@ protected override void SolveInstance(IGH_DataAccess DA)
                     {
                         surfaces.Add(new GH_Brep(brep));
                     }
-
-                    if (srf.FaceMesh != null)
-                    {
-                        meshes.Add(new GH_Mesh(srf.FaceMesh.ToRhinoGeo()));
-                    }
                 }
 
+                MeshBatch mesh = Component.GetWorldMesh(i);
+                if (mesh.TriangleCount > 0)
+                    meshes.Add(new GH_Mesh(mesh.ToRhinoGeo()));
+
                 foreach (Edge c in parentComponent.Edges)
                     curves.Add(new GH_Curve(c.ToRhinoGeo().ToNurbsCurve()));
 
@@ -431,6 +430,39 @@ public static Rhino.Geometry.Mesh ToRhinoGeo(this SketchUpNET.Mesh mesh, Transfo
             return m;
         }
 
+        /// <summary>
+        /// Converts a merged SketchUp Mesh Batch to a single Rhino Mesh
+        /// </summary>
+        public static Rhino.Geometry.Mesh ToRhinoGeo(this SketchUpNET.MeshBatch batch)
+        {
+            Rhino.Geometry.Mesh m = new Rhino.Geometry.Mesh();
+
+            double[] p = batch.Positions;
+            Rhino.Geometry.Point3d[] points = new Rhino.Geometry.Point3d[batch.VertexCount];
+            for (int i = 0; i < points.Length; i++)
+                points[i] = new Rhino.Geometry.Point3d(p[3 * i], p[3 * i + 1], p[3 * i + 2]);
+            m.Vertices.AddVertices(points);
+
+            int[] f = batch.Indices;
+            Rhino.Geometry.MeshFace[] faces = new Rhino.Geometry.MeshFace[batch.TriangleCount];
+            for (int i = 0; i < faces.Length; i++)
+                faces[i] = new Rhino.Geometry.MeshFace(f[3 * i], f[3 * i + 1], f[3 * i + 2]);
+            m.Faces.AddFaces(faces);
+
+            double[] n = batch.Normals;
+            if (n != null && n.Length == p.Length)
+            {
+                Rhino.Geometry.Vector3f[] normals = new Rhino.Geometry.Vector3f[batch.VertexCount];
+                for (int i = 0; i < normals.Length; i++)
+                    normals[i] = new Rhino.Geometry.Vector3f((float)n[3 * i], (float)n[3 * i + 1], (float)n[3 * i + 2]);
+                m.Normals.AddRange(normals);
+            }
+            else
+                m.Normals.ComputeNormals();
+
+            return m;
+        }
+
         public static void WriteModel(string path, List<GH_Surface> surfaces = null, List<GH_Curve> curves = null, bool append = false)
         {
             SketchUpNET.SketchUp skp = new SketchUpNET.SketchUp();
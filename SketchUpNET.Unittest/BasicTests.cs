@@ -1,6 +1,7 @@
 using System;
 using Microsoft.VisualStudio.TestTools.UnitTesting;
 using System.Collections.Generic;
+using System.Runtime.InteropServices;
 
 namespace SketchUpNET.Unittest
 {
@@ -32,6 +33,1031 @@ public void TestGetMesh()
             }
         }
 
+        /// <summary>
+        /// Test loading merged mesh batches from testfile
+        /// </summary>
+        [TestMethod]
+        public void TestGetMeshBatches()
+        {
+            SketchUpNET.SketchUp skp = new SketchUp();
+            Assert.IsTrue(skp.LoadMeshBatches(TestFile, MeshBatchGrouping.Material));
+            Assert.IsTrue(skp.MeshBatches.Count > 0);
+            foreach (var batch in skp.MeshBatches)
+            {
+                Assert.IsTrue(batch.TriangleCount > 0);
+                Assert.AreEqual(batch.Positions.Length, batch.Normals.Length);
+                Assert.AreEqual(batch.VertexCount * 2, batch.TexCoords.Length);
+                foreach (int index in batch.Indices)
+                    Assert.IsTrue(index >= 0 && index < batch.VertexCount);
+            }
+        }
+
+        /// <summary>
+        /// Test merging instance meshes into world space
+        /// </summary>
+        [TestMethod]
+        public void TestGetInstanceWorldMesh()
+        {
+            SketchUpNET.SketchUp skp = new SketchUp();
+            Assert.IsTrue(skp.LoadModel(TestFile, true));
+            foreach (var component in skp.Components.Values)
+                Assert.IsNotNull(component.MergedMesh);
+
+            foreach (var instance in skp.Instances)
+            {
+                Component parent = instance.Parent as Component;
+                MeshBatch mesh = Component.GetWorldMesh(instance);
+                Assert.AreEqual(parent.MergedMesh.TriangleCount, mesh.TriangleCount);
+                Assert.AreEqual(parent.MergedMesh.VertexCount, mesh.VertexCount);
+            }
+
+            int triangles = 0;
+            foreach (var instance in skp.Instances)
+                triangles += ((Component)instance.Parent).MergedMesh.TriangleCount;
+            Assert.AreEqual(triangles, Component.GetWorldMesh(skp.Instances).TriangleCount);
+        }
+
+        /// <summary>
+        /// Test loading surface loops as point rings
+        /// </summary>
+        [TestMethod]
+        public void TestLoopsAsPoints()
+        {
+            SketchUpNET.SketchUp edges = new SketchUp();
+            Assert.IsTrue(edges.LoadModel(TestFile));
+            SketchUpNET.SketchUp rings = new SketchUp();
+            Assert.IsTrue(rings.LoadModel(TestFile, new LoadOptions() { LoopsAsPoints = true }));
+
+            Assert.AreEqual(edges.Surfaces.Count, rings.Surfaces.Count);
+            for (int i = 0; i < rings.Surfaces.Count; i++)
+            {
+                PointRings r = rings.Surfaces[i].Rings;
+                Assert.AreEqual(edges.Surfaces[i].InnerEdges.Count + 1, r.Count);
+                Assert.AreEqual(edges.Surfaces[i].OuterEdges.Edges.Count, r.GetPointCount(0));
+                Assert.AreEqual(r.Offsets[r.Count] * 3, r.Points.Length);
+            }
+        }
+
+        /// <summary>
+        /// Test triangulating in memory surfaces with holes
+        /// </summary>
+        [TestMethod]
+        public void TestTriangulate()
+        {
+            Surface square = new Surface();
+            square.Vertices = new List<Vertex>() { new Vertex(0, 0, 0), new Vertex(0, 10, 0), new Vertex(10, 10, 0), new Vertex(10, 0, 0) };
+            Surface holed = new Surface();
+            holed.Rings = new PointRings(new int[] { 0, 4, 8 }, new double[] {
+                0, 0, 0, 10, 0, 0, 10, 0, 10, 0, 0, 10,
+                2, 0, 2, 4, 0, 2, 4, 0, 4, 2, 0, 4 });
+
+            Mesh mesh = square.Triangulate();
+            Assert.IsNotNull(mesh);
+            Assert.AreEqual(2, mesh.Faces.Count);
+
+            MeshBatch batch = Surface.Triangulate(new List<Surface>() { square, holed, new Surface() });
+            Assert.AreEqual(2 + 8, batch.TriangleCount);
+            Assert.AreEqual(batch.TriangleCount, batch.FaceIds.Length);
+            Assert.AreEqual(1, batch.FaceIds[batch.TriangleCount - 1]);
+        }
+
+        /// <summary>
+        /// Test batch face metrics against SketchUp's face areas
+        /// </summary>
+        [TestMethod]
+        public void TestFaceMetrics()
+        {
+            SketchUpNET.SketchUp skp = new SketchUp();
+            Assert.IsTrue(skp.LoadModel(TestFile, new LoadOptions() { LoopsAsPoints = true }));
+
+            FaceMetrics metrics = FaceMetrics.Compute(skp.Surfaces);
+            Assert.AreEqual(skp.Surfaces.Count, metrics.Count);
+            for (int i = 0; i < metrics.Count; i++)
+            {
+                // SketchUp reports areas in square inches
+                Assert.AreEqual(skp.Surfaces[i].Area * 0.0254 * 0.0254, metrics.Areas[i], 1e-6);
+                for (int j = 0; j < 3; j++)
+                {
+                    Assert.IsTrue(metrics.BoundsMin[3 * i + j] <= metrics.Centroids[3 * i + j] + 1e-9);
+                    Assert.IsTrue(metrics.BoundsMax[3 * i + j] >= metrics.Centroids[3 * i + j] - 1e-9);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Test closed shell and volume analysis
+        /// </summary>
+        [TestMethod]
+        public void TestAnalyzeSolids()
+        {
+            SketchUpNET.SketchUp skp = new SketchUp();
+            Assert.IsTrue(skp.LoadModel(TestFile, new LoadOptions() { AnalyzeSolids = true }));
+
+            foreach (var component in skp.Components.Values)
+            {
+                Assert.IsNotNull(component.Solid);
+                Assert.IsTrue(component.Solid.Area >= 0);
+            }
+
+            foreach (var group in skp.Groups)
+                Assert.IsNotNull(group.Solid);
+
+            foreach (var instance in skp.Instances)
+            {
+                Solid solid = Component.GetSolid(instance);
+                Assert.AreEqual(((Component)instance.Parent).Solid.IsClosed, solid.IsClosed);
+            }
+        }
+
+        /// <summary>
+        /// Test slicing a model with horizontal planes
+        /// </summary>
+        [TestMethod]
+        public void TestLoadSections()
+        {
+            double[] planes = SectionContour.HorizontalPlanes(0, 3, 0.5);
+            Assert.AreEqual(7 * 4, planes.Length);
+
+            SketchUpNET.SketchUp skp = new SketchUp();
+            Assert.IsTrue(skp.LoadSections(TestFile, planes));
+            foreach (var contour in skp.Sections)
+            {
+                Assert.IsTrue(contour.Plane >= 0 && contour.Plane < 7);
+                Assert.IsTrue(contour.Points.Length >= 6);
+                for (int i = 2; i < contour.Points.Length; i += 3)
+                    Assert.AreEqual(-planes[4 * contour.Plane + 3], contour.Points[i], 1e-9);
+            }
+        }
+
+        /// <summary>
+        /// Test simplifying mesh batches into levels of detail
+        /// </summary>
+        [TestMethod]
+        public void TestMeshBatchLods()
+        {
+            SketchUpNET.SketchUp skp = new SketchUp();
+            Assert.IsTrue(skp.LoadMeshBatches(TestFile, MeshBatchGrouping.Material, new double[] { 0.5, 0.1 }));
+            foreach (var batch in skp.MeshBatches)
+            {
+                Assert.AreEqual(2, batch.Lods.Count);
+                Assert.IsTrue(batch.Lods[0].TriangleCount <= batch.TriangleCount);
+                Assert.IsTrue(batch.Lods[1].TriangleCount <= batch.Lods[0].TriangleCount);
+                foreach (int index in batch.Lods[1].Indices)
+                    Assert.IsTrue(index >= 0 && index < batch.Lods[1].VertexCount);
+            }
+        }
+
+        /// <summary>
+        /// Test detecting clashes between instances
+        /// </summary>
+        [TestMethod]
+        public void TestClashDetection()
+        {
+            SketchUpNET.SketchUp skp = new SketchUp();
+            Assert.IsTrue(skp.LoadModel(TestFile, true));
+            List<Clash> clashes = Clash.Detect(skp.Instances, false, 0.001);
+            foreach (var clash in clashes)
+            {
+                Assert.AreNotEqual(clash.First, clash.Second);
+                Assert.IsTrue(clash.Penetration >= 0);
+            }
+        }
+
+        /// <summary>
+        /// Test clash detection of a flat panel passing through a box
+        /// </summary>
+        [TestMethod]
+        public void TestClashFlatPanel()
+        {
+            var box = new Component();
+            box.MergedMesh = new MeshBatch("box", "", null,
+                new double[] { 0, 0, 0, 1, 0, 0, 1, 1, 0, 0, 1, 0, 0, 0, 1, 1, 0, 1, 1, 1, 1, 0, 1, 1 },
+                null, null,
+                new int[] { 0, 2, 1, 0, 3, 2, 4, 5, 6, 4, 6, 7, 0, 1, 5, 0, 5, 4, 1, 2, 6, 1, 6, 5, 2, 3, 7, 2, 7, 6, 3, 0, 4, 3, 4, 7 });
+
+            var panel = new Component();
+            panel.MergedMesh = new MeshBatch("panel", "", null,
+                new double[] { 0.5, -0.5, -0.5, 0.5, 1.5, -0.5, 0.5, 1.5, 1.5, 0.5, -0.5, 1.5 },
+                null, null,
+                new int[] { 0, 1, 2, 0, 2, 3 });
+
+            var identity = new double[] { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+            var instances = new List<Instance>();
+            instances.Add(new Instance("box", "a", "box", new Transform(identity), "", null) { Parent = box });
+            instances.Add(new Instance("panel", "b", "panel", new Transform(identity), "", null) { Parent = panel });
+
+            List<Clash> clashes = Clash.Detect(instances, false, 0.001);
+            Assert.AreEqual(1, clashes.Count);
+            Assert.AreEqual(1.0, clashes[0].Penetration, 1e-9);
+        }
+
+        /// <summary>
+        /// Test deterministic surface point sampling
+        /// </summary>
+        [TestMethod]
+        public void TestPointSamples()
+        {
+            SketchUpNET.SketchUp skp = new SketchUp();
+            Assert.IsTrue(skp.LoadMeshBatches(TestFile, MeshBatchGrouping.Material));
+
+            PointSamples samples = PointSamples.SampleCount(skp.MeshBatches, null, 10000, 1);
+            PointSamples again = PointSamples.SampleCount(skp.MeshBatches, null, 10000, 1);
+            Assert.AreEqual(samples.Count, again.Count);
+            Assert.AreEqual(samples.Count, samples.Offsets[skp.MeshBatches.Count]);
+            Assert.AreEqual(samples.Count * 3, samples.Positions.Length);
+            for (int i = 0; i < samples.Positions.Length; i++)
+                Assert.AreEqual(samples.Positions[i], again.Positions[i]);
+            for (int i = 0; i < samples.Count; i++)
+            {
+                double x = samples.Normals[3 * i], y = samples.Normals[3 * i + 1], z = samples.Normals[3 * i + 2];
+                Assert.AreEqual(1.0, Math.Sqrt(x * x + y * y + z * z), 1e-5);
+            }
+            for (int b = 0; b < skp.MeshBatches.Count; b++)
+            {
+                MeshBatch batch = skp.MeshBatches[b];
+                Assert.AreEqual(batch.TriangleCount, batch.FaceIds.Length);
+                for (int i = samples.Offsets[b]; i < samples.Offsets[b + 1]; i++)
+                    Assert.IsTrue(samples.FaceIds[i] >= 0 && samples.FaceIds[i] < batch.FacePersistentIds.Length);
+            }
+        }
+
+        /// <summary>
+        /// Test loading arcs analytically and tessellating them on demand
+        /// </summary>
+        [TestMethod]
+        public void TestArcTable()
+        {
+            SketchUpNET.SketchUp skp = new SketchUp();
+            Assert.IsTrue(skp.LoadModel(TestFile, new LoadOptions() { ArcsAsTable = true }));
+            foreach (var curve in skp.Curves)
+                Assert.IsFalse(curve.isArc);
+
+            SketchUpNET.SketchUp full = new SketchUp();
+            Assert.IsTrue(full.LoadModel(TestFile));
+            if (skp.Arcs.Count > 0)
+                Assert.IsTrue(skp.Edges.Count < full.Edges.Count);
+
+            PointRings points = skp.Arcs.Tessellate(0.001);
+            Assert.AreEqual(skp.Arcs.Count, points.Count);
+            for (int i = 0; i < skp.Arcs.Count; i++)
+            {
+                for (int j = points.Offsets[i]; j < points.Offsets[i + 1]; j++)
+                {
+                    double x = points.Points[3 * j] - skp.Arcs.Centers[3 * i];
+                    double y = points.Points[3 * j + 1] - skp.Arcs.Centers[3 * i + 1];
+                    double z = points.Points[3 * j + 2] - skp.Arcs.Centers[3 * i + 2];
+                    Assert.AreEqual(skp.Arcs.Radii[i], Math.Sqrt(x * x + y * y + z * z), 1e-9);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Test reading projected attribute dictionary keys into columns
+        /// </summary>
+        [TestMethod]
+        public void TestLoadAttributes()
+        {
+            var projection = new Dictionary<string, string[]>() {
+                { "dynamic_attributes", null },
+                { "IFC 2x3", new string[] { "Name", "Tag" } } };
+
+            SketchUpNET.SketchUp skp = new SketchUp();
+            Assert.IsTrue(skp.LoadAttributes(TestFile, projection));
+            Assert.IsNotNull(skp.Attributes.GetColumn("IFC 2x3", "Tag"));
+            foreach (var column in skp.Attributes.Columns)
+            {
+                Assert.AreEqual(skp.Attributes.Count, column.HasValue.Length);
+                if (column.Type == AttributeType.String)
+                    Assert.AreEqual(skp.Attributes.Count, column.Strings.Length);
+            }
+            Assert.AreEqual(skp.Attributes.Count, new HashSet<long>(skp.Attributes.PersistentIds).Count);
+        }
+
+        /// <summary>
+        /// Test fetching single entities by persistent id from an open model
+        /// </summary>
+        [TestMethod]
+        public void TestFetchByPersistentId()
+        {
+            SketchUpNET.SketchUp skp = new SketchUp();
+            Assert.IsTrue(skp.LoadModel(TestFile, new LoadOptions() { IndexPersistentIds = true }));
+            Assert.IsTrue(skp.PersistentIndex.Count > 0);
+
+            List<long> pids = new List<long>();
+            foreach (var surface in skp.Surfaces)
+                pids.Add(surface.PersistentId);
+            foreach (var instance in skp.Instances)
+                pids.Add(instance.PersistentId);
+
+            using (ModelSession session = ModelSession.Open(TestFile))
+            {
+                Assert.IsNotNull(session);
+                List<FetchedEntity> fetched = session.Fetch(pids.ToArray());
+                Assert.AreEqual(pids.Count, fetched.Count);
+                for (int i = 0; i < pids.Count; i++)
+                    Assert.AreEqual(skp.PersistentIndex[pids[i]].GetType(), fetched[i].Entity.GetType());
+
+                foreach (var instance in skp.Instances)
+                {
+                    FetchedEntity entity = session.FetchPaths(new string[] { instance.PersistentId.ToString() })[0];
+                    Assert.AreEqual(instance.Guid, ((Instance)entity.Entity).Guid);
+                    Assert.IsNotNull(entity.Transformation);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Test skipping hidden entities and layers
+        /// </summary>
+        [TestMethod]
+        public void TestVisibleOnly()
+        {
+            WriteVisibilityModel("VisibilityModel.skp");
+
+            SketchUpNET.SketchUp all = new SketchUp();
+            Assert.IsTrue(all.LoadModel("VisibilityModel.skp"));
+            CollectionAssert.AreEquivalent(new int[] { 0, 1, 2, 3 }, SurfaceLevels(all));
+
+            LoadOptions options = new LoadOptions() { VisibleOnly = true };
+            SketchUpNET.SketchUp visible = new SketchUp();
+            Assert.IsTrue(visible.LoadModel("VisibilityModel.skp", options));
+            CollectionAssert.AreEquivalent(new int[] { 0, 3 }, SurfaceLevels(visible));
+
+            // The scene shows the hidden face but hides its own one, the layer stays hidden
+            SketchUpNET.SketchUp scene = new SketchUp();
+            Assert.IsTrue(scene.LoadModel("VisibilityModel.skp", "Fixture", options));
+            CollectionAssert.AreEquivalent(new int[] { 0, 1 }, SurfaceLevels(scene));
+            Assert.IsNotNull(scene.Camera);
+
+            // Options are not changed by loading and can be reused
+            Assert.IsTrue(visible.LoadModel("VisibilityModel.skp", options));
+            CollectionAssert.AreEquivalent(new int[] { 0, 3 }, SurfaceLevels(visible));
+
+            SketchUpNET.SketchUp model = new SketchUp();
+            Assert.IsTrue(model.LoadModel(TestFile, new LoadOptions() { VisibleOnly = true }));
+            foreach (var instance in model.Instances)
+                Assert.IsNotNull(instance.Parent);
+        }
+
+        /// <summary>
+        /// Height in inches of each loaded surface of the visibility model
+        /// </summary>
+        static List<int> SurfaceLevels(SketchUp skp)
+        {
+            List<int> levels = new List<int>();
+            foreach (var surface in skp.Surfaces)
+                levels.Add((int)Math.Round(surface.Vertices[0].Z / 0.0254));
+            return levels;
+        }
+
+        /// <summary>
+        /// Writes four unit squares at heights 0 to 3 inches: a visible one, a hidden one, one on a hidden layer
+        /// and one hidden by the scene "Fixture", which uses hidden geometry but not hidden layers
+        /// </summary>
+        static void WriteVisibilityModel(string filename)
+        {
+            SUInitialize();
+            IntPtr model;
+            SUModelCreate(out model);
+            IntPtr entities;
+            SUModelGetEntities(model, out entities);
+
+            IntPtr[] faces = new IntPtr[4];
+            for (int i = 0; i < faces.Length; i++)
+            {
+                double[] points = { 0, 0, i, 1, 0, i, 1, 1, i, 0, 1, i };
+                SUFaceCreateSimple(out faces[i], points, (UIntPtr)4);
+                SUEntitiesAddFaces(entities, (UIntPtr)1, new IntPtr[] { faces[i] });
+            }
+
+            SUDrawingElementSetHidden(SUFaceToDrawingElement(faces[1]), true);
+
+            IntPtr layer;
+            SULayerCreate(out layer);
+            SULayerSetName(layer, "Hidden");
+            SULayerSetVisibility(layer, false);
+            SUModelAddLayers(model, (UIntPtr)1, new IntPtr[] { layer });
+            SUDrawingElementSetLayer(SUFaceToDrawingElement(faces[2]), layer);
+
+            IntPtr scene;
+            SUSceneCreate(out scene);
+            SUSceneSetName(scene, "Fixture");
+            SUModelAddScenes(model, (UIntPtr)1, new IntPtr[] { scene });
+            SUSceneSetUseHiddenLayers(scene, false);
+            SUSceneSetUseHiddenGeometry(scene, true);
+            SUSceneSetDrawingElementHidden(scene, SUFaceToDrawingElement(faces[3]), true);
+
+            SUModelSaveToFile(model, filename);
+            SUModelRelease(ref model);
+            SUTerminate();
+        }
+
+        const string SketchUpApi = "SketchUpAPI.dll";
+        [DllImport(SketchUpApi)] static extern void SUInitialize();
+        [DllImport(SketchUpApi)] static extern void SUTerminate();
+        [DllImport(SketchUpApi)] static extern int SUModelCreate(out IntPtr model);
+        [DllImport(SketchUpApi)] static extern int SUModelRelease(ref IntPtr model);
+        [DllImport(SketchUpApi)] static extern int SUModelGetEntities(IntPtr model, out IntPtr entities);
+        [DllImport(SketchUpApi)] static extern int SUModelAddLayers(IntPtr model, UIntPtr len, IntPtr[] layers);
+        [DllImport(SketchUpApi)] static extern int SUModelAddScenes(IntPtr model, UIntPtr len, IntPtr[] scenes);
+        [DllImport(SketchUpApi)] static extern int SUModelSaveToFile(IntPtr model, [MarshalAs(UnmanagedType.LPStr)] string path);
+        [DllImport(SketchUpApi)] static extern int SUFaceCreateSimple(out IntPtr face, double[] points, UIntPtr len);
+        [DllImport(SketchUpApi)] static extern IntPtr SUFaceToDrawingElement(IntPtr face);
+        [DllImport(SketchUpApi)] static extern int SUEntitiesAddFaces(IntPtr entities, UIntPtr len, IntPtr[] faces);
+        [DllImport(SketchUpApi)] static extern int SUDrawingElementSetHidden(IntPtr element, [MarshalAs(UnmanagedType.I1)] bool hidden);
+        [DllImport(SketchUpApi)] static extern int SUDrawingElementSetLayer(IntPtr element, IntPtr layer);
+        [DllImport(SketchUpApi)] static extern int SULayerCreate(out IntPtr layer);
+        [DllImport(SketchUpApi)] static extern int SULayerSetName(IntPtr layer, [MarshalAs(UnmanagedType.LPStr)] string name);
+        [DllImport(SketchUpApi)] static extern int SULayerSetVisibility(IntPtr layer, [MarshalAs(UnmanagedType.I1)] bool visible);
+        [DllImport(SketchUpApi)] static extern int SUSceneCreate(out IntPtr scene);
+        [DllImport(SketchUpApi)] static extern int SUSceneSetName(IntPtr scene, [MarshalAs(UnmanagedType.LPStr)] string name);
+        [DllImport(SketchUpApi)] static extern int SUSceneSetUseHiddenLayers(IntPtr scene, [MarshalAs(UnmanagedType.I1)] bool use);
+        [DllImport(SketchUpApi)] static extern int SUSceneSetUseHiddenGeometry(IntPtr scene, [MarshalAs(UnmanagedType.I1)] bool use);
+        [DllImport(SketchUpApi)] static extern int SUSceneSetDrawingElementHidden(IntPtr scene, IntPtr element, [MarshalAs(UnmanagedType.I1)] bool hidden);
+        [DllImport(SketchUpApi)] static extern int SUGuidePointCreate(out IntPtr point, double[] position);
+        [DllImport(SketchUpApi)] static extern int SUEntitiesAddGuidePoints(IntPtr entities, UIntPtr len, IntPtr[] points);
+        [DllImport(SketchUpApi)] static extern int SUGuideLineCreateFinite(out IntPtr line, double[] start, double[] end);
+        [DllImport(SketchUpApi)] static extern int SUGuideLineCreateInfinite(out IntPtr line, double[] point, double[] direction);
+        [DllImport(SketchUpApi)] static extern int SUEntitiesAddGuideLines(IntPtr entities, UIntPtr len, IntPtr[] lines);
+        [DllImport(SketchUpApi)] static extern int SUTextCreate(out IntPtr text);
+        [DllImport(SketchUpApi)] static extern int SUTextSetString(IntPtr text, [MarshalAs(UnmanagedType.LPStr)] string value);
+        [DllImport(SketchUpApi)] static extern int SUTextSetPoint(IntPtr text, double[] point, IntPtr path);
+        [DllImport(SketchUpApi)] static extern int SUEntitiesAddTexts(IntPtr entities, UIntPtr len, IntPtr[] texts);
+        [DllImport(SketchUpApi)] static extern int SUImageRepCreate(out IntPtr rep);
+        [DllImport(SketchUpApi)] static extern int SUImageRepRelease(ref IntPtr rep);
+        [DllImport(SketchUpApi)] static extern int SUImageRepSetData(IntPtr rep, UIntPtr width, UIntPtr height, UIntPtr bitsPerPixel, UIntPtr rowPadding, byte[] data);
+        [DllImport(SketchUpApi)] static extern int SUImageCreateFromImageRep(out IntPtr image, IntPtr rep);
+        [DllImport(SketchUpApi)] static extern int SUEntitiesAddImage(IntPtr entities, IntPtr image);
+        [DllImport(SketchUpApi)] static extern int SUComponentDefinitionCreate(out IntPtr definition);
+        [DllImport(SketchUpApi)] static extern int SUComponentDefinitionSetName(IntPtr definition, [MarshalAs(UnmanagedType.LPStr)] string name);
+        [DllImport(SketchUpApi)] static extern int SUComponentDefinitionGetEntities(IntPtr definition, out IntPtr entities);
+        [DllImport(SketchUpApi)] static extern int SUComponentDefinitionCreateInstance(IntPtr definition, out IntPtr instance);
+        [DllImport(SketchUpApi)] static extern int SUModelAddComponentDefinitions(IntPtr model, UIntPtr len, IntPtr[] definitions);
+        [DllImport(SketchUpApi)] static extern int SUEntitiesAddInstance(IntPtr entities, IntPtr instance, IntPtr name);
+        [DllImport(SketchUpApi)] static extern int SUGroupCreate(out IntPtr group);
+        [DllImport(SketchUpApi)] static extern int SUGroupGetEntities(IntPtr group, out IntPtr entities);
+        [DllImport(SketchUpApi)] static extern int SUEntitiesAddGroup(IntPtr entities, IntPtr group);
+        [DllImport(SketchUpApi)] static extern int SUFaceGetEdges(IntPtr face, UIntPtr len, [Out] IntPtr[] edges, out UIntPtr count);
+        [DllImport(SketchUpApi)] static extern IntPtr SUEdgeToDrawingElement(IntPtr edge);
+        [DllImport(SketchUpApi)] static extern int SUEdgeSetSoft(IntPtr edge, [MarshalAs(UnmanagedType.I1)] bool soft);
+        [DllImport(SketchUpApi)] static extern int SUEdgeSetSmooth(IntPtr edge, [MarshalAs(UnmanagedType.I1)] bool smooth);
+        [DllImport(SketchUpApi)] static extern int SUGeometryInputCreate(out IntPtr input);
+        [DllImport(SketchUpApi)] static extern int SUGeometryInputRelease(ref IntPtr input);
+        [DllImport(SketchUpApi)] static extern int SUGeometryInputAddVertex(IntPtr input, double[] point);
+        [DllImport(SketchUpApi)] static extern int SUGeometryInputAddFace(IntPtr input, ref IntPtr loop, out UIntPtr index);
+        [DllImport(SketchUpApi)] static extern int SULoopInputCreate(out IntPtr loop);
+        [DllImport(SketchUpApi)] static extern int SULoopInputAddVertexIndex(IntPtr loop, UIntPtr index);
+        [DllImport(SketchUpApi)] static extern int SULoopInputEdgeSetSoft(IntPtr loop, UIntPtr index, [MarshalAs(UnmanagedType.I1)] bool soft);
+        [DllImport(SketchUpApi)] static extern int SUEntitiesFill(IntPtr entities, IntPtr input, [MarshalAs(UnmanagedType.I1)] bool weld);
+
+        /// <summary>
+        /// Test loading what a scene shows
+        /// </summary>
+        [TestMethod]
+        public void TestLoadScene()
+        {
+            SketchUpNET.SketchUp skp = new SketchUp();
+            LoadOptions options = new LoadOptions();
+            Assert.IsFalse(skp.LoadModel(TestFile, "No such scene", options));
+            Assert.IsNull(skp.Camera);
+            Assert.IsNull(options.Scene);
+            Assert.IsTrue(skp.LoadModel(TestFile, options));
+
+            // A missing scene leaves the loaded model untouched
+            var surfaces = skp.Surfaces;
+            Assert.IsFalse(skp.LoadModel(TestFile, "No such scene", options));
+            Assert.AreSame(surfaces, skp.Surfaces);
+
+            SketchUpNET.SketchUp visible = new SketchUp();
+            Assert.IsTrue(visible.LoadModel(TestFile, new LoadOptions() { VisibleOnly = true }));
+            Assert.IsNull(visible.Camera);
+        }
+
+        /// <summary>
+        /// Test reading scene cameras without geometry
+        /// </summary>
+        [TestMethod]
+        public void TestLoadViews()
+        {
+            SketchUpNET.SketchUp skp = new SketchUp();
+            Assert.IsTrue(skp.LoadViews(TestFile));
+            Assert.IsNull(skp.Surfaces);
+            Assert.AreEqual(skp.Views.Count * 3, skp.Views.Positions.Length);
+
+            for (int i = 0; i < skp.Views.Count; i++)
+            {
+                Assert.IsTrue(skp.Views.Far[i] >= skp.Views.Near[i]);
+                Assert.AreEqual(skp.Views.Near[i], skp.Views.GetCamera(i).Near);
+            }
+
+            if (skp.Views.Count > 0)
+            {
+                SketchUpNET.SketchUp scene = new SketchUp();
+                Assert.IsTrue(scene.LoadModel(TestFile, skp.Views.Names[0], new LoadOptions()));
+                Assert.AreEqual(scene.Camera.FieldOfView, skp.Views.FieldOfView[0]);
+                Assert.AreEqual(scene.Camera.OrthographicHeight, skp.Views.OrthographicHeight[0]);
+                Assert.AreEqual(scene.Camera.Position.X, skp.Views.Positions[0]);
+            }
+
+            var tables = ViewTable.FromFiles(new string[] { TestFile, "missing.skp" });
+            Assert.AreEqual(2, tables.Count);
+            Assert.AreEqual(skp.Views.Count, tables[0].Count);
+            Assert.IsNull(tables[1]);
+        }
+
+        /// <summary>
+        /// Test loading annotations into flat tables
+        /// </summary>
+        [TestMethod]
+        public void TestLoadAnnotations()
+        {
+            WriteAnnotationModel("AnnotationModel.skp");
+
+            SketchUpNET.SketchUp skp = new SketchUp();
+            Assert.IsTrue(skp.LoadModel("AnnotationModel.skp", new LoadOptions() { Annotations = AnnotationKinds.All }));
+            Assert.IsNotNull(skp.Annotations);
+            Assert.AreEqual(1, skp.Annotations.GuidePointCount);
+            Assert.AreEqual(skp.Annotations.GuidePointCount * 3, skp.Annotations.GuidePointAnchors.Length);
+            Assert.AreEqual(1, skp.Annotations.TextCount);
+            Assert.AreEqual("Fixture", skp.Annotations.Texts[0]);
+            Assert.AreEqual(skp.Annotations.TextCount * 3, skp.Annotations.TextPoints.Length);
+            Assert.AreEqual(3 * 0.0254, skp.Annotations.TextPoints[2], 1e-9);
+            Assert.AreEqual(skp.Annotations.DimensionCount * 6, skp.Annotations.DimensionPoints.Length);
+
+            // The finite guide line is ten inches long, the infinite one keeps its unit direction
+            Assert.AreEqual(2, skp.Annotations.GuideLineCount);
+            CollectionAssert.AreEquivalent(new bool[] { false, true }, skp.Annotations.GuideLineIsInfinite);
+            for (int i = 0; i < skp.Annotations.GuideLineCount; i++)
+            {
+                double x = skp.Annotations.GuideLineDirections[i * 3];
+                double y = skp.Annotations.GuideLineDirections[i * 3 + 1];
+                double z = skp.Annotations.GuideLineDirections[i * 3 + 2];
+                double length = skp.Annotations.GuideLineIsInfinite[i] ? 1 : 10 * 0.0254;
+                Assert.AreEqual(length, Math.Sqrt(x * x + y * y + z * z), 1e-9);
+            }
+
+            SketchUpNET.SketchUp texts = new SketchUp();
+            Assert.IsTrue(texts.LoadModel("AnnotationModel.skp", new LoadOptions() { Annotations = AnnotationKinds.Texts }));
+            Assert.AreEqual(skp.Annotations.TextCount, texts.Annotations.TextCount);
+            Assert.AreEqual(0, texts.Annotations.GuidePointCount);
+            Assert.IsNull(texts.Annotations.Polylines);
+
+            SketchUpNET.SketchUp none = new SketchUp();
+            Assert.IsTrue(none.LoadModel("AnnotationModel.skp"));
+            Assert.IsNull(none.Annotations);
+        }
+
+        /// <summary>
+        /// Writes a guide point, a finite and an infinite guide line and a text at (1, 2, 3) inches
+        /// </summary>
+        static void WriteAnnotationModel(string filename)
+        {
+            SUInitialize();
+            IntPtr model;
+            SUModelCreate(out model);
+            IntPtr entities;
+            SUModelGetEntities(model, out entities);
+
+            IntPtr point;
+            SUGuidePointCreate(out point, new double[] { 1, 1, 0 });
+            SUEntitiesAddGuidePoints(entities, (UIntPtr)1, new IntPtr[] { point });
+
+            IntPtr[] lines = new IntPtr[2];
+            SUGuideLineCreateFinite(out lines[0], new double[] { 0, 0, 0 }, new double[] { 10, 0, 0 });
+            SUGuideLineCreateInfinite(out lines[1], new double[] { 0, 0, 0 }, new double[] { 0, 0, 1 });
+            SUEntitiesAddGuideLines(entities, (UIntPtr)2, lines);
+
+            IntPtr text;
+            SUTextCreate(out text);
+            SUTextSetString(text, "Fixture");
+            SUTextSetPoint(text, new double[] { 1, 2, 3 }, IntPtr.Zero);
+            SUEntitiesAddTexts(entities, (UIntPtr)1, new IntPtr[] { text });
+
+            SUModelSaveToFile(model, filename);
+            SUModelRelease(ref model);
+            SUTerminate();
+        }
+
+        /// <summary>
+        /// Test listing images and reading their pixels on demand
+        /// </summary>
+        [TestMethod]
+        public void TestImagePixels()
+        {
+            WriteImageModel("ImageModel.skp");
+
+            SketchUpNET.SketchUp skp = new SketchUp();
+            Assert.IsTrue(skp.LoadModel("ImageModel.skp"));
+            Assert.IsNotNull(skp.Images);
+            Assert.AreEqual(3, skp.Images.Count);
+
+            using (ModelSession session = ModelSession.Open("ImageModel.skp"))
+            {
+                List<ImagePixels> decoded = new List<ImagePixels>();
+                foreach (SketchUpNET.Image image in skp.Images)
+                {
+                    ImagePixels pixels = session.GetPixels(image);
+                    Assert.IsNotNull(pixels);
+                    Assert.AreEqual(2, pixels.Width);
+                    Assert.AreEqual(image.PixelWidth, pixels.Width);
+                    Assert.AreEqual(image.PixelHeight, pixels.Height);
+                    Assert.AreSame(pixels, session.GetPixels(image));
+                    if (!decoded.Contains(pixels)) decoded.Add(pixels);
+                }
+
+                // Two images hold the same pixels and share them
+                Assert.AreEqual(2, decoded.Count);
+                Assert.IsNull(session.GetPixels(-1));
+            }
+        }
+
+        /// <summary>
+        /// Writes three 2x2 pixel images, the first two with equal pixels
+        /// </summary>
+        static void WriteImageModel(string filename)
+        {
+            SUInitialize();
+            IntPtr model;
+            SUModelCreate(out model);
+            IntPtr entities;
+            SUModelGetEntities(model, out entities);
+
+            for (int i = 0; i < 3; i++)
+            {
+                byte[] data = new byte[2 * 2 * 3];
+                for (int k = 0; k < data.Length; k++)
+                    data[k] = (byte)((i < 2) ? k * 20 : 255 - k);
+
+                IntPtr rep;
+                SUImageRepCreate(out rep);
+                SUImageRepSetData(rep, (UIntPtr)2, (UIntPtr)2, (UIntPtr)24, UIntPtr.Zero, data);
+                IntPtr image;
+                SUImageCreateFromImageRep(out image, rep);
+                SUEntitiesAddImage(entities, image);
+                SUImageRepRelease(ref rep);
+            }
+
+            SUModelSaveToFile(model, filename);
+            SUModelRelease(ref model);
+            SUTerminate();
+        }
+
+        /// <summary>
+        /// Test loading openings of faces and component definitions
+        /// </summary>
+        [TestMethod]
+        public void TestOpenings()
+        {
+            WriteComponentModel("ComponentModel.skp");
+
+            SketchUpNET.SketchUp skp = new SketchUp();
+            Assert.IsTrue(skp.LoadModel("ComponentModel.skp", new LoadOptions() { Openings = true }));
+            Assert.AreEqual(1, skp.Surfaces.Count);
+            Assert.AreEqual(1, skp.Components.Count);
+
+            // The C API can't glue instances to a face, so the wall is read without openings
+            foreach (Surface surface in skp.Surfaces)
+            {
+                Assert.IsNotNull(surface.Openings);
+                Assert.AreEqual(0, surface.Openings.Count);
+                Assert.AreEqual(surface.Openings.Offsets[surface.Openings.Count] * 3, surface.Openings.Points.Length);
+            }
+
+            foreach (Component component in skp.Components.Values)
+            {
+                Assert.IsNotNull(component.Openings);
+                Assert.AreEqual(component.Openings.Offsets[component.Openings.Count] * 3, component.Openings.Points.Length);
+            }
+
+            SketchUpNET.SketchUp plain = new SketchUp();
+            Assert.IsTrue(plain.LoadModel("ComponentModel.skp"));
+            Assert.AreEqual(1, plain.Surfaces.Count);
+            foreach (Surface surface in plain.Surfaces)
+                Assert.IsNull(surface.Openings);
+        }
+
+        /// <summary>
+        /// Writes a 100 inch wall face and two instances of the component "Window" holding a 10 inch face
+        /// </summary>
+        static void WriteComponentModel(string filename)
+        {
+            SUInitialize();
+            IntPtr model;
+            SUModelCreate(out model);
+            IntPtr entities;
+            SUModelGetEntities(model, out entities);
+
+            IntPtr wall;
+            SUFaceCreateSimple(out wall, new double[] { 0, 0, 0, 100, 0, 0, 100, 100, 0, 0, 100, 0 }, (UIntPtr)4);
+            SUEntitiesAddFaces(entities, (UIntPtr)1, new IntPtr[] { wall });
+
+            IntPtr definition;
+            SUComponentDefinitionCreate(out definition);
+            SUComponentDefinitionSetName(definition, "Window");
+            SUModelAddComponentDefinitions(model, (UIntPtr)1, new IntPtr[] { definition });
+
+            IntPtr definitionEntities;
+            SUComponentDefinitionGetEntities(definition, out definitionEntities);
+            IntPtr pane;
+            SUFaceCreateSimple(out pane, new double[] { 0, 0, 0, 10, 0, 0, 10, 10, 0, 0, 10, 0 }, (UIntPtr)4);
+            SUEntitiesAddFaces(definitionEntities, (UIntPtr)1, new IntPtr[] { pane });
+
+            for (int i = 0; i < 2; i++)
+            {
+                IntPtr instance;
+                SUComponentDefinitionCreateInstance(definition, out instance);
+                SUEntitiesAddInstance(entities, instance, IntPtr.Zero);
+            }
+
+            SUModelSaveToFile(model, filename);
+            SUModelRelease(ref model);
+            SUTerminate();
+        }
+
+        /// <summary>
+        /// Test loading classifications and dynamic component attributes per instance
+        /// </summary>
+        [TestMethod]
+        public void TestInstanceInfo()
+        {
+            WriteComponentModel("ComponentModel.skp");
+
+            SketchUpNET.SketchUp skp = new SketchUp();
+            Assert.IsTrue(skp.LoadModel("ComponentModel.skp", new LoadOptions()
+            {
+                Classifications = new Dictionary<string, string[]>() { { "IFC 2x3", null } },
+                DynamicAttributes = new string[0]
+            }));
+
+            Assert.IsNotNull(skp.InstanceInfo);
+            Assert.IsNotNull(skp.InstanceInfo.GetColumn("IFC 2x3", ""));
+            Assert.AreEqual(2, skp.Instances.Count);
+            Assert.AreEqual(skp.Instances.Count, skp.InstanceInfo.PersistentIds.Length);
+            Assert.AreNotEqual(skp.Instances[0].InfoRow, skp.Instances[1].InfoRow);
+            foreach (Instance instance in skp.Instances)
+                Assert.AreEqual(instance.PersistentId, skp.InstanceInfo.PersistentIds[instance.InfoRow]);
+
+            SketchUpNET.SketchUp plain = new SketchUp();
+            Assert.IsTrue(plain.LoadModel("ComponentModel.skp"));
+            Assert.IsNull(plain.InstanceInfo);
+            Assert.AreEqual(2, plain.Instances.Count);
+            foreach (Instance instance in plain.Instances)
+                Assert.AreEqual(-1, instance.InfoRow);
+        }
+
+        /// <summary>
+        /// Test copies of a group sharing their group definition
+        /// </summary>
+        [TestMethod]
+        public void TestGroupDefinitions()
+        {
+            WriteGroupModel("GroupModel.skp");
+
+            SketchUpNET.SketchUp skp = new SketchUp();
+            Assert.IsTrue(skp.LoadModel("GroupModel.skp"));
+            Assert.AreEqual(2, skp.Groups.Count);
+            Assert.AreEqual(2, skp.GroupDefinitions.Count);
+
+            foreach (Group group in skp.Groups)
+            {
+                Assert.AreEqual(1, group.Surfaces.Count);
+                Assert.IsNotNull(group.Definition);
+                Assert.AreSame(skp.GroupDefinitions[group.DefinitionGuid], group.Definition);
+                Assert.AreSame(group.Definition.Surfaces, group.Surfaces);
+                Assert.IsNotNull(group.Transformation);
+            }
+        }
+
+        /// <summary>
+        /// Writes two groups holding a unit square each
+        /// </summary>
+        static void WriteGroupModel(string filename)
+        {
+            SUInitialize();
+            IntPtr model;
+            SUModelCreate(out model);
+            IntPtr entities;
+            SUModelGetEntities(model, out entities);
+
+            for (int i = 0; i < 2; i++)
+            {
+                IntPtr group;
+                SUGroupCreate(out group);
+                SUEntitiesAddGroup(entities, group);
+
+                IntPtr groupEntities;
+                SUGroupGetEntities(group, out groupEntities);
+                IntPtr face;
+                SUFaceCreateSimple(out face, new double[] { 0, 0, i, 1, 0, i, 1, 1, i, 0, 1, i }, (UIntPtr)4);
+                SUEntitiesAddFaces(groupEntities, (UIntPtr)1, new IntPtr[] { face });
+            }
+
+            SUModelSaveToFile(model, filename);
+            SUModelRelease(ref model);
+            SUTerminate();
+        }
+
+        /// <summary>
+        /// Test edge flags and skipping soft, smooth and hidden edges
+        /// </summary>
+        [TestMethod]
+        public void TestEdgeFlags()
+        {
+            WriteEdgeModel("EdgeModel.skp");
+
+            SketchUpNET.SketchUp all = new SketchUp();
+            Assert.IsTrue(all.LoadModel("EdgeModel.skp"));
+            Assert.AreEqual(4, all.Edges.Count);
+
+            EdgeFlags flagged = EdgeFlags.Soft | EdgeFlags.Smooth | EdgeFlags.Hidden;
+            SketchUpNET.SketchUp hard = new SketchUp();
+            Assert.IsTrue(hard.LoadModel("EdgeModel.skp", new LoadOptions() { SkipEdges = flagged }));
+
+            foreach (EdgeFlags flag in new EdgeFlags[] { EdgeFlags.Soft, EdgeFlags.Smooth, EdgeFlags.Hidden })
+                Assert.AreEqual(1, all.Edges.FindAll(edge => (edge.Flags & flag) != EdgeFlags.None).Count);
+
+            int hardCount = 0;
+            foreach (Edge edge in all.Edges)
+                if ((edge.Flags & flagged) == EdgeFlags.None) hardCount++;
+
+            Assert.AreEqual(1, hardCount);
+            Assert.AreEqual(hardCount, hard.Edges.Count);
+            foreach (Edge edge in hard.Edges)
+                Assert.AreEqual(EdgeFlags.None, edge.Flags & flagged);
+        }
+
+        /// <summary>
+        /// Writes a unit square whose edges are soft, smooth, hidden and hard
+        /// </summary>
+        static void WriteEdgeModel(string filename)
+        {
+            SUInitialize();
+            IntPtr model;
+            SUModelCreate(out model);
+            IntPtr entities;
+            SUModelGetEntities(model, out entities);
+
+            IntPtr face;
+            SUFaceCreateSimple(out face, new double[] { 0, 0, 0, 1, 0, 0, 1, 1, 0, 0, 1, 0 }, (UIntPtr)4);
+            SUEntitiesAddFaces(entities, (UIntPtr)1, new IntPtr[] { face });
+
+            IntPtr[] edges = new IntPtr[4];
+            UIntPtr count;
+            SUFaceGetEdges(face, (UIntPtr)edges.Length, edges, out count);
+            SUEdgeSetSoft(edges[0], true);
+            SUEdgeSetSmooth(edges[1], true);
+            SUDrawingElementSetHidden(SUEdgeToDrawingElement(edges[2]), true);
+
+            SUModelSaveToFile(model, filename);
+            SUModelRelease(ref model);
+            SUTerminate();
+        }
+
+        /// <summary>
+        /// Test per vertex mesh normals and crease aware smooth normals of mesh batches
+        /// </summary>
+        [TestMethod]
+        public void TestSmoothNormals()
+        {
+            SketchUpNET.SketchUp skp = new SketchUp();
+            skp.LoadModel(TestFile, true);
+            foreach (var srf in skp.Surfaces)
+                Assert.AreEqual(srf.FaceMesh.Vertices.Count, srf.FaceMesh.Normals.Count);
+
+            Assert.IsTrue(skp.LoadMeshBatches(TestFile, MeshBatchGrouping.Material));
+            MeshBatch.SmoothNormals(skp.MeshBatches, 30);
+            foreach (var batch in skp.MeshBatches)
+            {
+                Assert.AreEqual(batch.Positions.Length, batch.Normals.Length);
+                for (int i = 0; i < batch.VertexCount; i++)
+                {
+                    double x = batch.Normals[3 * i], y = batch.Normals[3 * i + 1], z = batch.Normals[3 * i + 2];
+                    Assert.AreEqual(1.0, Math.Sqrt(x * x + y * y + z * z), 1e-6);
+                }
+            }
+
+            // Faces folded at a right angle blend across their soft edge despite the 30 degree crease angle
+            WriteSoftEdgeModel("SoftEdgeModel.skp");
+            SketchUpNET.SketchUp soft = new SketchUp();
+            Assert.IsTrue(soft.LoadMeshBatches("SoftEdgeModel.skp", MeshBatchGrouping.All));
+            Assert.AreEqual(1, soft.MeshBatches.Count);
+            MeshBatch folded = soft.MeshBatches[0];
+            Assert.AreEqual(4, folded.TriangleCount);
+            folded.SmoothNormals(30);
+
+            int blended = 0;
+            for (int i = 0; i < folded.VertexCount; i++)
+            {
+                double y = Math.Abs(folded.Normals[3 * i + 1]), z = Math.Abs(folded.Normals[3 * i + 2]);
+                bool onEdge = Math.Abs(folded.Positions[3 * i + 1]) < 1e-9 && Math.Abs(folded.Positions[3 * i + 2]) < 1e-9;
+                if (onEdge)
+                {
+                    Assert.AreEqual(Math.Sqrt(0.5), y, 1e-6);
+                    Assert.AreEqual(Math.Sqrt(0.5), z, 1e-6);
+                    blended++;
+                }
+                else
+                    Assert.AreEqual(1.0, Math.Max(y, z), 1e-6);
+            }
+            Assert.AreEqual(4, blended);
+        }
+
+        /// <summary>
+        /// Writes two 10 inch squares folded at a right angle along a soft edge on the x axis
+        /// </summary>
+        static void WriteSoftEdgeModel(string filename)
+        {
+            SUInitialize();
+            IntPtr model;
+            SUModelCreate(out model);
+            IntPtr entities;
+            SUModelGetEntities(model, out entities);
+
+            IntPtr input;
+            SUGeometryInputCreate(out input);
+            double[][] points = {
+                new double[] { 0, 0, 0 }, new double[] { 10, 0, 0 }, new double[] { 10, 10, 0 },
+                new double[] { 0, 10, 0 }, new double[] { 10, 0, 10 }, new double[] { 0, 0, 10 } };
+            foreach (double[] point in points)
+                SUGeometryInputAddVertex(input, point);
+
+            // Each loop starts with the shared edge between vertex 0 and 1
+            int[][] loops = { new int[] { 0, 1, 2, 3 }, new int[] { 1, 0, 5, 4 } };
+            foreach (int[] loop in loops)
+            {
+                IntPtr loopInput;
+                SULoopInputCreate(out loopInput);
+                foreach (int vertex in loop)
+                    SULoopInputAddVertexIndex(loopInput, (UIntPtr)vertex);
+                SULoopInputEdgeSetSoft(loopInput, UIntPtr.Zero, true);
+                UIntPtr face;
+                SUGeometryInputAddFace(input, ref loopInput, out face);
+            }
+
+            SUEntitiesFill(entities, input, true);
+            SUGeometryInputRelease(ref input);
+
+            SUModelSaveToFile(model, filename);
+            SUModelRelease(ref model);
+            SUTerminate();
+        }
+
+        /// <summary>
+        /// Test vertex cache optimization of mesh batches
+        /// </summary>
+        [TestMethod]
+        public void TestOptimizeMeshBatches()
+        {
+            SketchUpNET.SketchUp skp = new SketchUp();
+            Assert.IsTrue(skp.LoadMeshBatches(TestFile, MeshBatchGrouping.Material));
+            var triangles = new List<int>();
+            foreach (var batch in skp.MeshBatches)
+                triangles.Add(batch.TriangleCount);
+
+            var reports = MeshBatch.Optimize(skp.MeshBatches, 16);
+            Assert.AreEqual(skp.MeshBatches.Count, reports.Count);
+            for (int i = 0; i < reports.Count; i++)
+            {
+                var batch = skp.MeshBatches[i];
+                Assert.AreEqual(triangles[i], batch.TriangleCount);
+                Assert.AreEqual(reports[i].AcmrAfter, batch.Acmr(16), 1e-9);
+                Assert.IsTrue(reports[i].AcmrAfter > 0 && reports[i].AcmrAfter <= 3);
+                foreach (int index in batch.Indices)
+                    Assert.IsTrue(index >= 0 && index < batch.VertexCount);
+            }
+        }
+
+        /// <summary>
+        /// Test meshlets of component definitions
+        /// </summary>
+        [TestMethod]
+        public void TestMeshlets()
+        {
+            SketchUpNET.SketchUp skp = new SketchUp();
+            skp.LoadModel(TestFile, true);
+            skp.BuildMeshlets(64, 124);
+
+            foreach (var component in skp.Components.Values)
+            {
+                var batch = component.MergedMesh;
+                var meshlets = batch.Meshlets;
+                Assert.IsNotNull(meshlets);
+                Assert.AreEqual(batch.TriangleCount, meshlets.TriangleOffsets[meshlets.Count]);
+                for (int i = 0; i < meshlets.Count; i++)
+                {
+                    Assert.IsTrue(meshlets.GetVertexCount(i) <= 64);
+                    Assert.IsTrue(meshlets.GetTriangleCount(i) <= 124);
+                    for (int t = meshlets.TriangleOffsets[i]; t < meshlets.TriangleOffsets[i + 1]; t++)
+                        for (int k = 0; k < 3; k++)
+                            Assert.IsTrue(meshlets.Triangles[3 * t + k] < meshlets.GetVertexCount(i));
+                }
+
+                // Reordered triangles invalidate the meshlets
+                batch.Optimize(32);
+                Assert.IsNull(batch.Meshlets);
+            }
+        }
+
         /// <summary>
         /// Test saving file as
         /// </summary>
@@ -0,0 +1,358 @@
+/*
+
+SketchUpNET - a C++ Wrapper for the Trimble(R) SketchUp(R) C API
+Copyright(C) 2015, Autor: Maximilian Thumfart
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+#pragma once
+
+#include <SketchUpAPI/slapi.h>
+#include <SketchUpAPI/geometry.h>
+#include <SketchUpAPI/unicodestring.h>
+#include <SketchUpAPI/model/entities.h>
+#include <SketchUpAPI/model/drawing_element.h>
+#include <SketchUpAPI/model/guide_point.h>
+#include <SketchUpAPI/model/guide_line.h>
+#include <SketchUpAPI/model/polyline3d.h>
+#include <SketchUpAPI/model/text.h>
+#include <SketchUpAPI/model/dimension.h>
+#include <SketchUpAPI/model/dimension_linear.h>
+#include <SketchUpAPI/model/dimension_radial.h>
+#include <SketchUpAPI/model/instancepath.h>
+#include <vector>
+#include "utilities.h"
+#include "PointRings.h"
+#include "LoadContext.h"
+
+using namespace System;
+using namespace System::Collections;
+using namespace System::Collections::Generic;
+
+namespace SketchUpNET
+{
+	/// <summary>
+	/// Guide points, guide lines, polylines, texts and dimensions of an entity collection in flat buffers.
+	/// Points are stored as x,y,z triplets in meters, only kinds requested by LoadOptions.Annotations are filled.
+	/// </summary>
+	public ref class AnnotationTable
+	{
+	public:
+		/// <summary>
+		/// Guide point positions
+		/// </summary>
+		array<double>^ GuidePoints;
+
+		/// <summary>
+		/// Points the guide points have been measured from
+		/// </summary>
+		array<double>^ GuidePointAnchors;
+
+		/// <summary>
+		/// Guide line start points
+		/// </summary>
+		array<double>^ GuideLineOrigins;
+
+		/// <summary>
+		/// Guide line directions, their length is the length of finite guide lines in meters.
+		/// Infinite guide lines keep unit vectors.
+		/// </summary>
+		array<double>^ GuideLineDirections;
+
+		array<bool>^ GuideLineIsInfinite;
+
+		/// <summary>
+		/// Polyline points, ring i holds the points of polyline i
+		/// </summary>
+		PointRings^ Polylines;
+
+		array<System::String^>^ Texts;
+
+		/// <summary>
+		/// Points the texts are attached to
+		/// </summary>
+		array<double>^ TextPoints;
+
+		/// <summary>
+		/// Leader vectors of the texts in meters
+		/// </summary>
+		array<double>^ TextLeaders;
+
+		/// <summary>
+		/// Displayed text of each dimension
+		/// </summary>
+		array<System::String^>^ DimensionTexts;
+
+		/// <summary>
+		/// Radial dimension, otherwise linear
+		/// </summary>
+		array<bool>^ DimensionIsRadial;
+
+		/// <summary>
+		/// Two points per dimension: start and end of linear dimensions,
+		/// the arrow point on the curve and the opposite point of radial dimensions
+		/// </summary>
+		array<double>^ DimensionPoints;
+
+		property int GuidePointCount
+		{
+			int get() { return (GuidePoints == nullptr) ? 0 : GuidePoints->Length / 3; }
+		}
+
+		property int GuideLineCount
+		{
+			int get() { return (GuideLineIsInfinite == nullptr) ? 0 : GuideLineIsInfinite->Length; }
+		}
+
+		property int PolylineCount
+		{
+			int get() { return (Polylines == nullptr) ? 0 : Polylines->Count; }
+		}
+
+		property int TextCount
+		{
+			int get() { return (Texts == nullptr) ? 0 : Texts->Length; }
+		}
+
+		property int DimensionCount
+		{
+			int get() { return (DimensionTexts == nullptr) ? 0 : DimensionTexts->Length; }
+		}
+
+		AnnotationTable(){};
+
+	internal:
+		static AnnotationTable^ FromEntities(SUEntitiesRef entities, LoadContext^ context)
+		{
+			AnnotationTable^ table = gcnew AnnotationTable();
+			AnnotationKinds kinds = context->Options->Annotations;
+
+			if ((kinds & AnnotationKinds::GuidePoints) != AnnotationKinds::None)
+				ReadGuidePoints(table, entities, context);
+			if ((kinds & AnnotationKinds::GuideLines) != AnnotationKinds::None)
+				ReadGuideLines(table, entities, context);
+			if ((kinds & AnnotationKinds::Polylines) != AnnotationKinds::None)
+				ReadPolylines(table, entities, context);
+			if ((kinds & AnnotationKinds::Texts) != AnnotationKinds::None)
+				ReadTexts(table, entities, context);
+			if ((kinds & AnnotationKinds::Dimensions) != AnnotationKinds::None)
+				ReadDimensions(table, entities, context);
+
+			return table;
+		}
+
+		static void Append(std::vector<double>& values, const SUPoint3D& point)
+		{
+			values.push_back(point.x * 0.0254);
+			values.push_back(point.y * 0.0254);
+			values.push_back(point.z * 0.0254);
+		}
+
+		static void Append(std::vector<double>& values, const SUVector3D& vector)
+		{
+			values.push_back(vector.x * 0.0254);
+			values.push_back(vector.y * 0.0254);
+			values.push_back(vector.z * 0.0254);
+		}
+
+		static void ReadGuidePoints(AnnotationTable^ table, SUEntitiesRef entities, LoadContext^ context)
+		{
+			size_t count = 0;
+			SUEntitiesGetNumGuidePoints(entities, &count);
+			std::vector<SUGuidePointRef> guides(count);
+			if (count > 0)
+				SUEntitiesGetGuidePoints(entities, count, &guides[0], &count);
+
+			std::vector<double> positions, anchors;
+			for (size_t i = 0; i < count; i++)
+			{
+				if (!context->IsVisible(SUGuidePointToDrawingElement(guides[i]))) continue;
+
+				SUPoint3D position = SU_INVALID;
+				SUPoint3D anchor = SU_INVALID;
+				SUGuidePointGetPosition(guides[i], &position);
+				SUGuidePointGetFromPosition(guides[i], &anchor);
+				Append(positions, position);
+				Append(anchors, anchor);
+			}
+
+			table->GuidePoints = Utilities::ToArray(positions);
+			table->GuidePointAnchors = Utilities::ToArray(anchors);
+		}
+
+		static void ReadGuideLines(AnnotationTable^ table, SUEntitiesRef entities, LoadContext^ context)
+		{
+			size_t count = 0;
+			SUEntitiesGetNumGuideLines(entities, &count);
+			std::vector<SUGuideLineRef> guides(count);
+			if (count > 0)
+				SUEntitiesGetGuideLines(entities, count, &guides[0], &count);
+
+			std::vector<double> origins, directions;
+			std::vector<bool> infinite;
+			for (size_t i = 0; i < count; i++)
+			{
+				if (!context->IsVisible(SUGuideLineToDrawingElement(guides[i]))) continue;
+
+				SUPoint3D origin = SU_INVALID;
+				SUVector3D direction = SU_INVALID;
+				bool isInfinite = false;
+				SUGuideLineGetData(guides[i], &origin, &direction, &isInfinite);
+				Append(origins, origin);
+				if (isInfinite)
+				{
+					directions.push_back(direction.x);
+					directions.push_back(direction.y);
+					directions.push_back(direction.z);
+				}
+				else
+					Append(directions, direction);
+				infinite.push_back(isInfinite);
+			}
+
+			table->GuideLineOrigins = Utilities::ToArray(origins);
+			table->GuideLineDirections = Utilities::ToArray(directions);
+			table->GuideLineIsInfinite = gcnew array<bool>((int)infinite.size());
+			for (int i = 0; i < table->GuideLineIsInfinite->Length; i++)
+				table->GuideLineIsInfinite[i] = infinite[i];
+		}
+
+		static void ReadPolylines(AnnotationTable^ table, SUEntitiesRef entities, LoadContext^ context)
+		{
+			size_t count = 0;
+			SUEntitiesGetNumPolyline3ds(entities, &count);
+			std::vector<SUPolyline3dRef> lines(count);
+			if (count > 0)
+				SUEntitiesGetPolyline3ds(entities, count, &lines[0], &count);
+
+			std::vector<int> offsets(1, 0);
+			std::vector<double> points;
+			std::vector<SUPoint3D> buffer;
+			for (size_t i = 0; i < count; i++)
+			{
+				if (!context->IsVisible(SUPolyline3dToDrawingElement(lines[i]))) continue;
+
+				size_t pointCount = 0;
+				SUPolyline3dGetNumPoints(lines[i], &pointCount);
+				buffer.resize(pointCount);
+				if (pointCount > 0)
+					SUPolyline3dGetPoints(lines[i], pointCount, &buffer[0], &pointCount);
+
+				for (size_t k = 0; k < pointCount; k++)
+					Append(points, buffer[k]);
+				offsets.push_back(offsets.back() + (int)pointCount);
+			}
+
+			table->Polylines = gcnew PointRings(Utilities::ToArray(offsets), Utilities::ToArray(points));
+		}
+
+		static void ReadTexts(AnnotationTable^ table, SUEntitiesRef entities, LoadContext^ context)
+		{
+			size_t count = 0;
+			SUEntitiesGetNumTexts(entities, &count);
+			std::vector<SUTextRef> texts(count);
+			if (count > 0)
+				SUEntitiesGetTexts(entities, count, &texts[0], &count);
+
+			List<String^>^ strings = gcnew List<String^>();
+			std::vector<double> points, leaders;
+			for (size_t i = 0; i < count; i++)
+			{
+				if (!context->IsVisible(SUTextToDrawingElement(texts[i]))) continue;
+
+				SUStringRef text = SU_INVALID;
+				SUStringCreate(&text);
+				SUTextGetString(texts[i], &text);
+				strings->Add(Utilities::GetString(text));
+				SUStringRelease(&text);
+
+				SUPoint3D point = SU_INVALID;
+				SUInstancePathRef path = SU_INVALID;
+				SUTextGetPoint(texts[i], &point, &path);
+				if (SUIsValid(path))
+					SUInstancePathRelease(&path);
+				Append(points, point);
+
+				SUVector3D leader = SU_INVALID;
+				SUTextGetLeaderVector(texts[i], &leader);
+				Append(leaders, leader);
+			}
+
+			table->Texts = strings->ToArray();
+			table->TextPoints = Utilities::ToArray(points);
+			table->TextLeaders = Utilities::ToArray(leaders);
+		}
+
+		static void ReadDimensions(AnnotationTable^ table, SUEntitiesRef entities, LoadContext^ context)
+		{
+			size_t count = 0;
+			SUEntitiesGetNumDimensions(entities, &count);
+			std::vector<SUDimensionRef> dimensions(count);
+			if (count > 0)
+				SUEntitiesGetDimensions(entities, count, &dimensions[0], &count);
+
+			List<String^>^ strings = gcnew List<String^>();
+			std::vector<bool> radial;
+			std::vector<double> points;
+			for (size_t i = 0; i < count; i++)
+			{
+				if (!context->IsVisible(SUDimensionToDrawingElement(dimensions[i]))) continue;
+
+				SUDimensionType type = SUDimensionType_Invalid;
+				SUDimensionGetType(dimensions[i], &type);
+				if (type == SUDimensionType_Invalid) continue;
+
+				SUStringRef text = SU_INVALID;
+				SUStringCreate(&text);
+				SUDimensionGetText(dimensions[i], &text);
+				strings->Add(Utilities::GetString(text));
+				SUStringRelease(&text);
+
+				if (type == SUDimensionType_Radial)
+				{
+					SUPoint3D leader[3];
+					SUDimensionRadialGetLeaderPoints(SUDimensionRadialFromDimension(dimensions[i]), leader);
+					Append(points, leader[1]);
+					Append(points, leader[2]);
+				}
+				else
+				{
+					SUDimensionLinearRef linear = SUDimensionLinearFromDimension(dimensions[i]);
+					SUPoint3D start = SU_INVALID;
+					SUPoint3D end = SU_INVALID;
+					SUInstancePathRef path = SU_INVALID;
+					SUDimensionLinearGetStartPoint(linear, &start, &path);
+					if (SUIsValid(path))
+						SUInstancePathRelease(&path);
+					SUDimensionLinearGetEndPoint(linear, &end, &path);
+					if (SUIsValid(path))
+						SUInstancePathRelease(&path);
+					Append(points, start);
+					Append(points, end);
+				}
+				radial.push_back(type == SUDimensionType_Radial);
+			}
+
+			table->DimensionTexts = strings->ToArray();
+			table->DimensionPoints = Utilities::ToArray(points);
+			table->DimensionIsRadial = gcnew array<bool>((int)radial.size());
+			for (int i = 0; i < table->DimensionIsRadial->Length; i++)
+				table->DimensionIsRadial[i] = radial[i];
+		}
+	};
+
+
+}
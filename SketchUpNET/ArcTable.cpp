@@ -0,0 +1,296 @@
+/*
+
+SketchUpNET - a C++ Wrapper for the Trimble(R) SketchUp(R) C API
+Copyright(C) 2015, Autor: Maximilian Thumfart
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <SketchUpAPI/slapi.h>
+#include <SketchUpAPI/geometry.h>
+#include <SketchUpAPI/model/entities.h>
+#include <SketchUpAPI/model/curve.h>
+#include <SketchUpAPI/model/arccurve.h>
+#include <SketchUpAPI/model/edge.h>
+#include <SketchUpAPI/model/drawing_element.h>
+#include <SketchUpAPI/model/layer.h>
+#include <vector>
+#include <cmath>
+#include "utilities.h"
+#include "PointRings.h"
+#include "LoadContext.h"
+
+using namespace System;
+using namespace System::Collections;
+using namespace System::Collections::Generic;
+
+namespace SketchUpNET
+{
+	/// <summary>
+	/// Segmentation of an arc given by center, radius, axes and angles
+	/// </summary>
+	struct ArcSegmenter
+	{
+		/// <summary>
+		/// Number of segments keeping the chord within tolerance of the arc
+		/// </summary>
+		static int Segments(double radius, double sweep, bool full, double tolerance)
+		{
+			int minimum = full ? 3 : 1;
+			if (radius <= 0 || tolerance <= 0) return minimum;
+
+			double step = (tolerance >= radius) ? 3.14159265358979323846 : 2.0 * acos(1.0 - tolerance / radius);
+			int count = (int)ceil(sweep / step);
+			return (count < minimum) ? minimum : count;
+		}
+
+		static double Sweep(double start, double end, bool full)
+		{
+			const double twoPi = 2.0 * 3.14159265358979323846;
+			if (full) return twoPi;
+			double sweep = end - start;
+			while (sweep <= 0) sweep += twoPi;
+			return sweep;
+		}
+
+		/// <summary>
+		/// Writes the points of an arc, full circles without repeating the first point
+		/// </summary>
+		static void Write(const double* center, const double* xAxis, const double* yAxis, double radius, double start, double sweep, int segments, bool full, double* out)
+		{
+			int count = full ? segments : segments + 1;
+			for (int i = 0; i < count; i++)
+			{
+				double angle = start + sweep * i / segments;
+				double c = radius * cos(angle);
+				double s = radius * sin(angle);
+				for (int k = 0; k < 3; k++)
+					out[3 * i + k] = center[k] + c * xAxis[k] + s * yAxis[k];
+			}
+		}
+	};
+
+	/// <summary>
+	/// Arcs and circles stored analytically in flat buffers, one entry per arc curve.
+	/// Points are tessellated on demand at a given tolerance, see Tessellate.
+	/// </summary>
+	public ref class ArcTable
+	{
+	public:
+		/// <summary>
+		/// Arc centers in meters as x,y,z triplets
+		/// </summary>
+		array<double>^ Centers;
+
+		/// <summary>
+		/// Unit vectors to the point at angle 0 as x,y,z triplets
+		/// </summary>
+		array<double>^ XAxes;
+
+		/// <summary>
+		/// Unit vectors to the point at angle pi/2 as x,y,z triplets
+		/// </summary>
+		array<double>^ YAxes;
+
+		/// <summary>
+		/// Unit normals of the arc planes as x,y,z triplets
+		/// </summary>
+		array<double>^ Normals;
+
+		/// <summary>
+		/// Radii in meters
+		/// </summary>
+		array<double>^ Radii;
+
+		/// <summary>
+		/// Start angles in radians
+		/// </summary>
+		array<double>^ StartAngles;
+
+		/// <summary>
+		/// End angles in radians
+		/// </summary>
+		array<double>^ EndAngles;
+
+		/// <summary>
+		/// Indicates full circles
+		/// </summary>
+		array<bool>^ IsFullCircle;
+
+		/// <summary>
+		/// Layer of the first edge of each arc, equal names share one string
+		/// </summary>
+		array<System::String^>^ Layers;
+
+		property int Count
+		{
+			int get() { return (Radii == nullptr) ? 0 : Radii->Length; }
+		}
+
+		ArcTable(int count)
+		{
+			this->Centers = gcnew array<double>(3 * count);
+			this->XAxes = gcnew array<double>(3 * count);
+			this->YAxes = gcnew array<double>(3 * count);
+			this->Normals = gcnew array<double>(3 * count);
+			this->Radii = gcnew array<double>(count);
+			this->StartAngles = gcnew array<double>(count);
+			this->EndAngles = gcnew array<double>(count);
+			this->IsFullCircle = gcnew array<bool>(count);
+			this->Layers = gcnew array<System::String^>(count);
+		};
+
+		ArcTable(){};
+
+		/// <summary>
+		/// Returns the points of an arc as x,y,z triplets with no chord further than tolerance from the arc.
+		/// Full circles don't repeat their first point.
+		/// </summary>
+		/// <param name="arc">Arc index</param>
+		/// <param name="tolerance">Maximum chord deviation in meters</param>
+		array<double>^ Tessellate(int arc, double tolerance)
+		{
+			double sweep = ArcSegmenter::Sweep(StartAngles[arc], EndAngles[arc], IsFullCircle[arc]);
+			int segments = ArcSegmenter::Segments(Radii[arc], sweep, IsFullCircle[arc], tolerance);
+			int points = IsFullCircle[arc] ? segments : segments + 1;
+
+			std::vector<double> values(3 * points);
+			WriteArc(arc, sweep, segments, &values[0]);
+			return Utilities::ToArray(values);
+		}
+
+		/// <summary>
+		/// Tessellates all arcs into point rings, ring i holds the points of arc i
+		/// </summary>
+		/// <param name="tolerance">Maximum chord deviation in meters</param>
+		PointRings^ Tessellate(double tolerance)
+		{
+			std::vector<int> offsets(1, 0);
+			std::vector<double> sweeps(Count);
+			std::vector<int> segments(Count);
+			for (int i = 0; i < Count; i++)
+			{
+				sweeps[i] = ArcSegmenter::Sweep(StartAngles[i], EndAngles[i], IsFullCircle[i]);
+				segments[i] = ArcSegmenter::Segments(Radii[i], sweeps[i], IsFullCircle[i], tolerance);
+				offsets.push_back(offsets.back() + (IsFullCircle[i] ? segments[i] : segments[i] + 1));
+			}
+
+			std::vector<double> points(3 * offsets.back());
+			for (int i = 0; i < Count; i++)
+				WriteArc(i, sweeps[i], segments[i], points.empty() ? NULL : &points[3 * offsets[i]]);
+
+			return gcnew PointRings(Utilities::ToArray(offsets), Utilities::ToArray(points));
+		}
+
+	internal:
+		void WriteArc(int arc, double sweep, int segments, double* out)
+		{
+			double center[3], xAxis[3], yAxis[3];
+			for (int k = 0; k < 3; k++)
+			{
+				center[k] = Centers[3 * arc + k];
+				xAxis[k] = XAxes[3 * arc + k];
+				yAxis[k] = YAxes[3 * arc + k];
+			}
+			ArcSegmenter::Write(center, xAxis, yAxis, Radii[arc], StartAngles[arc], sweep, segments, IsFullCircle[arc], out);
+		}
+
+		static void SetVector(array<double>^ values, int index, double x, double y, double z, bool normalize)
+		{
+			double length = normalize ? sqrt(x * x + y * y + z * z) : 1.0;
+			if (length == 0) length = 1.0;
+			values[3 * index] = x / length;
+			values[3 * index + 1] = y / length;
+			values[3 * index + 2] = z / length;
+		}
+
+		static ArcTable^ FromEntities(SUEntitiesRef entities, LoadContext^ context)
+		{
+			size_t count = 0;
+			SUEntitiesGetNumArcCurves(entities, &count);
+			if (count == 0) return gcnew ArcTable(0);
+
+			std::vector<SUArcCurveRef> arcs(count);
+			SUEntitiesGetArcCurves(entities, count, &arcs[0], &count);
+
+			// Arcs share the visibility of their edges
+			std::vector<SUArcCurveRef> visible;
+			for (size_t i = 0; i < count; i++)
+			{
+				SUEdgeRef edge = SU_INVALID;
+				size_t edgeCount = 0;
+				SUCurveGetEdges(SUArcCurveToCurve(arcs[i]), 1, &edge, &edgeCount);
+				if (edgeCount == 0 || context->IsVisible(SUEdgeToDrawingElement(edge)))
+					visible.push_back(arcs[i]);
+			}
+			arcs.swap(visible);
+			count = arcs.size();
+
+			ArcTable^ table = gcnew ArcTable((int)count);
+			Dictionary<String^, String^>^ layers = gcnew Dictionary<String^, String^>();
+
+			for (int i = 0; i < (int)count; i++)
+			{
+				SUPoint3D center = SU_INVALID;
+				SUVector3D xAxis = SU_INVALID;
+				SUVector3D yAxis = SU_INVALID;
+				SUVector3D normal = SU_INVALID;
+				double radius = 0, start = 0, end = 0;
+				bool full = false;
+
+				SUArcCurveGetCenter(arcs[i], &center);
+				SUArcCurveGetXAxis(arcs[i], &xAxis);
+				SUArcCurveGetYAxis(arcs[i], &yAxis);
+				SUArcCurveGetNormal(arcs[i], &normal);
+				SUArcCurveGetRadius(arcs[i], &radius);
+				SUArcCurveGetStartAngle(arcs[i], &start);
+				SUArcCurveGetEndAngle(arcs[i], &end);
+				SUArcCurveGetIsFullCircle(arcs[i], &full);
+
+				SetVector(table->Centers, i, center.x * 0.0254, center.y * 0.0254, center.z * 0.0254, false);
+				SetVector(table->XAxes, i, xAxis.x, xAxis.y, xAxis.z, true);
+				SetVector(table->YAxes, i, yAxis.x, yAxis.y, yAxis.z, true);
+				SetVector(table->Normals, i, normal.x, normal.y, normal.z, true);
+				table->Radii[i] = radius * 0.0254;
+				table->StartAngles[i] = start;
+				table->EndAngles[i] = end;
+				table->IsFullCircle[i] = full;
+
+				System::String^ layername = System::String::Empty;
+				SUEdgeRef edge = SU_INVALID;
+				size_t edgeCount = 0;
+				SUCurveGetEdges(SUArcCurveToCurve(arcs[i]), 1, &edge, &edgeCount);
+				if (edgeCount > 0)
+				{
+					SULayerRef layer = SU_INVALID;
+					SUDrawingElementGetLayer(SUEdgeToDrawingElement(edge), &layer);
+					if (!SUIsInvalid(layer))
+						layername = Utilities::GetLayerName(layer);
+				}
+
+				if (!layers->ContainsKey(layername))
+					layers->Add(layername, layername);
+				table->Layers[i] = layers[layername];
+			}
+
+			return table;
+		}
+	};
+
+
+}
@@ -0,0 +1,634 @@
+/*
+
+SketchUpNET - a C++ Wrapper for the Trimble(R) SketchUp(R) C API
+Copyright(C) 2015, Autor: Maximilian Thumfart
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <SketchUpAPI/slapi.h>
+#include <SketchUpAPI/color.h>
+#include <SketchUpAPI/unicodestring.h>
+#include <SketchUpAPI/model/model.h>
+#include <SketchUpAPI/model/entity.h>
+#include <SketchUpAPI/model/entities.h>
+#include <SketchUpAPI/model/face.h>
+#include <SketchUpAPI/model/edge.h>
+#include <SketchUpAPI/model/group.h>
+#include <SketchUpAPI/model/component_definition.h>
+#include <SketchUpAPI/model/component_instance.h>
+#include <SketchUpAPI/model/attribute_dictionary.h>
+#include <SketchUpAPI/model/typed_value.h>
+#include <vector>
+#include <map>
+#include <set>
+#include <string>
+#include <cstdio>
+#include "utilities.h"
+
+using namespace System;
+using namespace System::Collections;
+using namespace System::Collections::Generic;
+
+namespace SketchUpNET
+{
+	/// <summary>
+	/// Storage of an attribute column
+	/// </summary>
+	public enum class AttributeType
+	{
+		/// <summary>
+		/// Byte, short, int, bool, time in seconds since 1970 and colors as ARGB, stored in Integers
+		/// </summary>
+		Integer = 0,
+
+		/// <summary>
+		/// Float and double values, stored in Doubles
+		/// </summary>
+		Double = 1,
+
+		/// <summary>
+		/// Strings, arrays and columns of mixed types as text, stored in Strings
+		/// </summary>
+		String = 2,
+
+		/// <summary>
+		/// 3D vectors, stored as x,y,z triplets in Vectors
+		/// </summary>
+		Vector = 3
+	};
+
+	struct AttributeCell
+	{
+		int Row;
+		int Storage;
+		long long Integer;
+		double Number[3];
+		std::string Text;
+	};
+
+	struct AttributeColumnData
+	{
+		std::string Dictionary;
+		std::string Key;
+		std::vector<AttributeCell> Cells;
+	};
+
+	struct AttributeProjection
+	{
+		bool AllKeys;
+		std::vector<std::string> Keys;
+		std::vector<int> Columns;
+		std::map<std::string, int> Discovered;
+	};
+
+	/// <summary>
+	/// Reads projected keys of attribute dictionaries into sparse columns,
+	/// entities without a projected value don't get a row. Contents shared by copies of a group are read once.
+	/// </summary>
+	class AttributeReader
+	{
+	public:
+		std::map<std::string, AttributeProjection> Projection;
+		std::vector<AttributeColumnData> Columns;
+		std::vector<long long> Rows;
+
+		AttributeReader()
+		{
+			value = SU_INVALID;
+			SUTypedValueCreate(&value);
+		}
+
+		~AttributeReader()
+		{
+			SUTypedValueRelease(&value);
+		}
+
+		/// <summary>
+		/// Requests keys of a dictionary, all keys if none are given
+		/// </summary>
+		void Project(const std::string& dictionary, const std::vector<std::string>& keys)
+		{
+			AttributeProjection& projection = Projection[dictionary];
+			projection.AllKeys = keys.empty();
+			for (size_t i = 0; i < keys.size(); i++)
+			{
+				projection.Keys.push_back(keys[i]);
+				projection.Columns.push_back(AddColumn(dictionary, keys[i]));
+			}
+		}
+
+		void ReadModel(SUModelRef model)
+		{
+			SUEntitiesRef entities = SU_INVALID;
+			SUModelGetEntities(model, &entities);
+			ReadEntities(entities);
+
+			size_t count = 0;
+			SUModelGetNumComponentDefinitions(model, &count);
+			if (count > 0)
+			{
+				std::vector<SUComponentDefinitionRef> definitions(count);
+				SUModelGetComponentDefinitions(model, count, &definitions[0], &count);
+				for (size_t i = 0; i < count; i++)
+				{
+					ReadEntity(SUComponentDefinitionToEntity(definitions[i]));
+
+					SUEntitiesRef definitionEntities = SU_INVALID;
+					SUComponentDefinitionGetEntities(definitions[i], &definitionEntities);
+					ReadEntities(definitionEntities);
+				}
+			}
+		}
+
+		void ReadEntities(SUEntitiesRef entities)
+		{
+			if (!visited.insert(entities.ptr).second) return;
+
+			size_t count = 0;
+			SUEntitiesGetNumFaces(entities, &count);
+			if (count > 0)
+			{
+				std::vector<SUFaceRef> faces(count);
+				SUEntitiesGetFaces(entities, count, &faces[0], &count);
+				for (size_t i = 0; i < count; i++)
+					ReadEntity(SUFaceToEntity(faces[i]));
+			}
+
+			count = 0;
+			SUEntitiesGetNumEdges(entities, false, &count);
+			if (count > 0)
+			{
+				std::vector<SUEdgeRef> edges(count);
+				SUEntitiesGetEdges(entities, false, count, &edges[0], &count);
+				for (size_t i = 0; i < count; i++)
+					ReadEntity(SUEdgeToEntity(edges[i]));
+			}
+
+			count = 0;
+			SUEntitiesGetNumInstances(entities, &count);
+			if (count > 0)
+			{
+				std::vector<SUComponentInstanceRef> instances(count);
+				SUEntitiesGetInstances(entities, count, &instances[0], &count);
+				for (size_t i = 0; i < count; i++)
+					ReadEntity(SUComponentInstanceToEntity(instances[i]));
+			}
+
+			count = 0;
+			SUEntitiesGetNumGroups(entities, &count);
+			if (count > 0)
+			{
+				std::vector<SUGroupRef> groups(count);
+				SUEntitiesGetGroups(entities, count, &groups[0], &count);
+				for (size_t i = 0; i < count; i++)
+				{
+					ReadEntity(SUGroupToEntity(groups[i]));
+
+					SUEntitiesRef groupEntities = SU_INVALID;
+					SUGroupGetEntities(groups[i], &groupEntities);
+					ReadEntities(groupEntities);
+				}
+			}
+		}
+
+		void ReadEntity(SUEntityRef entity)
+		{
+			size_t count = 0;
+			SUEntityGetNumAttributeDictionaries(entity, &count);
+			if (count == 0) return;
+
+			std::vector<SUAttributeDictionaryRef> dictionaries(count);
+			SUEntityGetAttributeDictionaries(entity, count, &dictionaries[0], &count);
+
+			int row = -1;
+			for (size_t i = 0; i < count; i++)
+			{
+				std::string name = GetName(dictionaries[i]);
+				std::map<std::string, AttributeProjection>::iterator found = Projection.find(name);
+				if (found == Projection.end()) continue;
+
+				AttributeProjection& projection = found->second;
+				if (projection.AllKeys)
+					Discover(name, dictionaries[i], projection);
+
+				for (size_t k = 0; k < projection.Keys.size(); k++)
+				{
+					if (SUAttributeDictionaryGetValue(dictionaries[i], projection.Keys[k].c_str(), &value) != SU_ERROR_NONE) continue;
+
+					AttributeCell cell;
+					if (!ReadValue(value, cell)) continue;
+
+					if (row < 0)
+					{
+						int64_t pid = 0;
+						SUEntityGetPersistentID(entity, &pid);
+						row = (int)Rows.size();
+						Rows.push_back(pid);
+					}
+					cell.Row = row;
+					Columns[projection.Columns[k]].Cells.push_back(cell);
+				}
+
+				// Discovered keys are only valid for the current dictionary
+				if (projection.AllKeys)
+				{
+					projection.Keys.clear();
+					projection.Columns.clear();
+				}
+			}
+		}
+
+		/// <summary>
+		/// Reads a typed value, false for empty values
+		/// </summary>
+		static bool ReadValue(SUTypedValueRef typed, AttributeCell& cell)
+		{
+			cell.Storage = (int)AttributeType::Integer;
+			cell.Integer = 0;
+			cell.Number[0] = cell.Number[1] = cell.Number[2] = 0;
+
+			SUTypedValueType type = SUTypedValueType_Empty;
+			SUTypedValueGetType(typed, &type);
+
+			switch (type)
+			{
+			case SUTypedValueType_Byte:
+			{
+				char byte = 0;
+				SUTypedValueGetByte(typed, &byte);
+				cell.Integer = byte;
+				return true;
+			}
+			case SUTypedValueType_Short:
+			{
+				int16_t number = 0;
+				SUTypedValueGetInt16(typed, &number);
+				cell.Integer = number;
+				return true;
+			}
+			case SUTypedValueType_Int32:
+			{
+				int32_t number = 0;
+				SUTypedValueGetInt32(typed, &number);
+				cell.Integer = number;
+				return true;
+			}
+			case SUTypedValueType_Bool:
+			{
+				bool flag = false;
+				SUTypedValueGetBool(typed, &flag);
+				cell.Integer = flag ? 1 : 0;
+				return true;
+			}
+			case SUTypedValueType_Time:
+			{
+				int64_t time = 0;
+				SUTypedValueGetTime(typed, &time);
+				cell.Integer = time;
+				return true;
+			}
+			case SUTypedValueType_Color:
+			{
+				SUColor color = SU_INVALID;
+				SUTypedValueGetColor(typed, &color);
+				cell.Integer = ((long long)color.alpha << 24) | ((long long)color.red << 16) | ((long long)color.green << 8) | (long long)color.blue;
+				return true;
+			}
+			case SUTypedValueType_Float:
+			{
+				float number = 0;
+				SUTypedValueGetFloat(typed, &number);
+				cell.Storage = (int)AttributeType::Double;
+				cell.Number[0] = number;
+				return true;
+			}
+			case SUTypedValueType_Double:
+			{
+				cell.Storage = (int)AttributeType::Double;
+				SUTypedValueGetDouble(typed, &cell.Number[0]);
+				return true;
+			}
+			case SUTypedValueType_Vector3D:
+			{
+				cell.Storage = (int)AttributeType::Vector;
+				SUTypedValueGetVector3d(typed, cell.Number);
+				return true;
+			}
+			case SUTypedValueType_String:
+			{
+				SUStringRef text = SU_INVALID;
+				SUStringCreate(&text);
+				SUTypedValueGetString(typed, &text);
+				cell.Storage = (int)AttributeType::String;
+				cell.Text = Utilities::GetNativeString(text);
+				SUStringRelease(&text);
+				return true;
+			}
+			case SUTypedValueType_Array:
+			{
+				size_t count = 0;
+				SUTypedValueGetNumArrayItems(typed, &count);
+				cell.Storage = (int)AttributeType::String;
+				cell.Text = "[";
+				if (count > 0)
+				{
+					std::vector<SUTypedValueRef> items(count);
+					SUTypedValueGetArrayItems(typed, count, &items[0], &count);
+					for (size_t i = 0; i < count; i++)
+					{
+						AttributeCell item;
+						if (i > 0) cell.Text += ", ";
+						if (ReadValue(items[i], item)) cell.Text += Format(item);
+					}
+				}
+				cell.Text += "]";
+				return true;
+			}
+			default:
+				return false;
+			}
+		}
+
+		/// <summary>
+		/// Text of a value, used for arrays and columns of mixed types
+		/// </summary>
+		static std::string Format(const AttributeCell& cell)
+		{
+			char buffer[96];
+			switch (cell.Storage)
+			{
+			case (int)AttributeType::Integer:
+				snprintf(buffer, sizeof(buffer), "%lld", cell.Integer);
+				return buffer;
+			case (int)AttributeType::Double:
+				snprintf(buffer, sizeof(buffer), "%.17g", cell.Number[0]);
+				return buffer;
+			case (int)AttributeType::Vector:
+				snprintf(buffer, sizeof(buffer), "%.17g, %.17g, %.17g", cell.Number[0], cell.Number[1], cell.Number[2]);
+				return buffer;
+			default:
+				return cell.Text;
+			}
+		}
+
+	private:
+		SUTypedValueRef value;
+		std::set<void*> visited;
+
+		int AddColumn(const std::string& dictionary, const std::string& key)
+		{
+			AttributeColumnData column;
+			column.Dictionary = dictionary;
+			column.Key = key;
+			Columns.push_back(column);
+			return (int)Columns.size() - 1;
+		}
+
+		void Discover(const std::string& dictionary, SUAttributeDictionaryRef attributes, AttributeProjection& projection)
+		{
+			size_t count = 0;
+			SUAttributeDictionaryGetNumKeys(attributes, &count);
+			if (count == 0) return;
+
+			std::vector<SUStringRef> keys(count);
+			for (size_t i = 0; i < count; i++)
+			{
+				keys[i] = SU_INVALID;
+				SUStringCreate(&keys[i]);
+			}
+			SUAttributeDictionaryGetKeys(attributes, count, &keys[0], &count);
+
+			for (size_t i = 0; i < keys.size(); i++)
+			{
+				if (i < count)
+				{
+					std::string key = Utilities::GetNativeString(keys[i]);
+					std::map<std::string, int>::iterator found = projection.Discovered.find(key);
+					int column = (found == projection.Discovered.end()) ? AddColumn(dictionary, key) : found->second;
+					projection.Discovered[key] = column;
+					projection.Keys.push_back(key);
+					projection.Columns.push_back(column);
+				}
+				SUStringRelease(&keys[i]);
+			}
+		}
+
+		static std::string GetName(SUAttributeDictionaryRef dictionary)
+		{
+			SUStringRef name = SU_INVALID;
+			SUStringCreate(&name);
+			SUAttributeDictionaryGetName(dictionary, &name);
+			std::string result = Utilities::GetNativeString(name);
+			SUStringRelease(&name);
+			return result;
+		}
+	};
+
+	/// <summary>
+	/// Values of one attribute dictionary key, one entry per row of the AttributeTable.
+	/// Only the array matching Type is set.
+	/// </summary>
+	public ref class AttributeColumn
+	{
+	public:
+		/// <summary>
+		/// Name of the attribute dictionary
+		/// </summary>
+		System::String^ Dictionary;
+
+		/// <summary>
+		/// Attribute key
+		/// </summary>
+		System::String^ Key;
+
+		/// <summary>
+		/// Storage of the values
+		/// </summary>
+		AttributeType Type;
+
+		/// <summary>
+		/// Indicates rows holding a value for this key
+		/// </summary>
+		array<bool>^ HasValue;
+
+		/// <summary>
+		/// Values of Integer columns
+		/// </summary>
+		array<Int64>^ Integers;
+
+		/// <summary>
+		/// Values of Double columns
+		/// </summary>
+		array<double>^ Doubles;
+
+		/// <summary>
+		/// Values of String columns
+		/// </summary>
+		array<System::String^>^ Strings;
+
+		/// <summary>
+		/// Values of Vector columns as x,y,z triplets
+		/// </summary>
+		array<double>^ Vectors;
+
+		AttributeColumn(){};
+
+	internal:
+		/// <summary>
+		/// Converts native cells, equal strings of all columns sharing the strings dictionary share one instance
+		/// </summary>
+		static AttributeColumn^ FromData(const AttributeColumnData& data, int rows, Dictionary<String^, String^>^ strings)
+		{
+			AttributeColumn^ column = gcnew AttributeColumn();
+			column->Dictionary = Utilities::GetString(data.Dictionary);
+			column->Key = Utilities::GetString(data.Key);
+			column->HasValue = gcnew array<bool>(rows);
+
+			// Mixed types fall back to text
+			int storage = data.Cells.empty() ? (int)AttributeType::String : data.Cells[0].Storage;
+			for (size_t i = 1; i < data.Cells.size(); i++)
+				if (data.Cells[i].Storage != storage) storage = (int)AttributeType::String;
+			column->Type = (AttributeType)storage;
+
+			switch (column->Type)
+			{
+			case AttributeType::Integer: column->Integers = gcnew array<Int64>(rows); break;
+			case AttributeType::Double: column->Doubles = gcnew array<double>(rows); break;
+			case AttributeType::Vector: column->Vectors = gcnew array<double>(3 * rows); break;
+			default: column->Strings = gcnew array<System::String^>(rows); break;
+			}
+
+			for (size_t i = 0; i < data.Cells.size(); i++)
+			{
+				const AttributeCell& cell = data.Cells[i];
+				column->HasValue[cell.Row] = true;
+				switch (column->Type)
+				{
+				case AttributeType::Integer: column->Integers[cell.Row] = cell.Integer; break;
+				case AttributeType::Double: column->Doubles[cell.Row] = cell.Number[0]; break;
+				case AttributeType::Vector:
+					for (int k = 0; k < 3; k++)
+						column->Vectors[3 * cell.Row + k] = cell.Number[k];
+					break;
+				default:
+				{
+					System::String^ text = Utilities::GetString(AttributeReader::Format(cell));
+					System::String^ shared = nullptr;
+					if (strings->TryGetValue(text, shared))
+						text = shared;
+					else
+						strings->Add(text, text);
+					column->Strings[cell.Row] = text;
+					break;
+				}
+				}
+			}
+
+			return column;
+		}
+	};
+
+	/// <summary>
+	/// Attribute values of all entities holding at least one requested key, stored column wise.
+	/// Rows are identified by the entities' persistent ids.
+	/// </summary>
+	public ref class AttributeTable
+	{
+	public:
+		/// <summary>
+		/// Persistent id of the entity of each row
+		/// </summary>
+		array<Int64>^ PersistentIds;
+
+		/// <summary>
+		/// One column per requested or discovered key
+		/// </summary>
+		List<AttributeColumn^>^ Columns;
+
+		property int Count
+		{
+			int get() { return (PersistentIds == nullptr) ? 0 : PersistentIds->Length; }
+		}
+
+		AttributeTable(){};
+
+		/// <summary>
+		/// Returns the column of a key or null if it hasn't been read
+		/// </summary>
+		/// <param name="dictionary">Name of the attribute dictionary</param>
+		/// <param name="key">Attribute key</param>
+		AttributeColumn^ GetColumn(System::String^ dictionary, System::String^ key)
+		{
+			for each (AttributeColumn^ column in Columns)
+			{
+				if (System::String::Equals(column->Dictionary, dictionary) && System::String::Equals(column->Key, key))
+					return column;
+			}
+			return nullptr;
+		}
+
+	internal:
+		/// <summary>
+		/// Reads the projected keys of all entities of a model, including component definitions and their contents.
+		/// Values of other dictionaries and keys are never marshaled. Hidden entities are read as well.
+		/// </summary>
+		static AttributeTable^ FromModel(SUModelRef model, Dictionary<String^, array<String^>^>^ projection)
+		{
+			AttributeReader reader;
+			for each (KeyValuePair<String^, array<String^>^> entry in projection)
+			{
+				std::vector<std::string> keys;
+				if (entry.Value != nullptr)
+				{
+					for each (String^ key in entry.Value)
+						keys.push_back(ToNative(key));
+				}
+				reader.Project(ToNative(entry.Key), keys);
+			}
+
+			reader.ReadModel(model);
+			return FromData(reader.Rows, reader.Columns);
+		}
+
+		static AttributeTable^ FromData(const std::vector<long long>& rows, const std::vector<AttributeColumnData>& columns)
+		{
+			AttributeTable^ table = gcnew AttributeTable();
+			table->PersistentIds = gcnew array<Int64>((int)rows.size());
+			for (int i = 0; i < table->PersistentIds->Length; i++)
+				table->PersistentIds[i] = rows[i];
+
+			Dictionary<String^, String^>^ strings = gcnew Dictionary<String^, String^>();
+			table->Columns = gcnew List<AttributeColumn^>();
+			for (size_t i = 0; i < columns.size(); i++)
+				table->Columns->Add(AttributeColumn::FromData(columns[i], table->Count, strings));
+
+			return table;
+		}
+
+		static std::string ToNative(System::String^ value)
+		{
+			const char* text = Utilities::ToString(value);
+			std::string result(text);
+			delete[] text;
+			return result;
+		}
+	};
+
+
+}
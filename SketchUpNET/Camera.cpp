@@ -0,0 +1,140 @@
+/*
+
+SketchUpNET - a C++ Wrapper for the Trimble(R) SketchUp(R) C API
+Copyright(C) 2015, Autor: Maximilian Thumfart
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <SketchUpAPI/slapi.h>
+#include <SketchUpAPI/geometry.h>
+#include <SketchUpAPI/model/camera.h>
+#include "Vertex.h"
+#include "Vector.h"
+
+using namespace System;
+using namespace System::Collections;
+using namespace System::Collections::Generic;
+
+namespace SketchUpNET
+{
+	public ref class Camera
+	{
+	public:
+		/// <summary>
+		/// Eye position
+		/// </summary>
+		Vertex^ Position;
+
+		/// <summary>
+		/// Point the camera looks at
+		/// </summary>
+		Vertex^ Target;
+
+		/// <summary>
+		/// Up direction
+		/// </summary>
+		Vector^ Up;
+
+		/// <summary>
+		/// Perspective or parallel projection
+		/// </summary>
+		bool Perspective;
+
+		/// <summary>
+		/// Field of view in degrees of perspective cameras
+		/// </summary>
+		double FieldOfView;
+
+		/// <summary>
+		/// Field of view is measured vertically, otherwise horizontally
+		/// </summary>
+		bool FieldOfViewIsHeight;
+
+		/// <summary>
+		/// Width to height ratio, 0 if the camera uses the aspect ratio of the viewport
+		/// </summary>
+		double AspectRatio;
+
+		/// <summary>
+		/// View height in meters of parallel projection cameras
+		/// </summary>
+		double OrthographicHeight;
+
+		/// <summary>
+		/// Near clipping distance in meters
+		/// </summary>
+		double Near;
+
+		/// <summary>
+		/// Far clipping distance in meters
+		/// </summary>
+		double Far;
+
+		Camera(Vertex^ position, Vertex^ target, Vector^ up)
+		{
+			this->Position = position;
+			this->Target = target;
+			this->Up = up;
+		};
+
+		Camera(){};
+
+	internal:
+		static Camera^ FromSU(SUCameraRef camera)
+		{
+			SUPoint3D position = SU_INVALID;
+			SUPoint3D target = SU_INVALID;
+			SUVector3D up = SU_INVALID;
+			SUCameraGetOrientation(camera, &position, &target, &up);
+
+			Camera^ v = gcnew Camera(Vertex::FromSU(position), Vertex::FromSU(target), Vector::FromSU(up));
+
+			bool perspective = true;
+			SUCameraGetPerspective(camera, &perspective);
+			v->Perspective = perspective;
+
+			double fov = 0;
+			if (SUCameraGetPerspectiveFrustumFOV(camera, &fov) == SU_ERROR_NONE)
+				v->FieldOfView = fov;
+
+			bool fovIsHeight = true;
+			SUCameraGetFOVIsHeight(camera, &fovIsHeight);
+			v->FieldOfViewIsHeight = fovIsHeight;
+
+			double aspect = 0;
+			if (SUCameraGetAspectRatio(camera, &aspect) == SU_ERROR_NONE)
+				v->AspectRatio = aspect;
+
+			double height = 0;
+			if (SUCameraGetOrthographicFrustumHeight(camera, &height) == SU_ERROR_NONE)
+				v->OrthographicHeight = height * 0.0254;
+
+			double znear = 0, zfar = 0;
+			if (SUCameraGetClippingDistances(camera, &znear, &zfar) == SU_ERROR_NONE)
+			{
+				v->Near = znear * 0.0254;
+				v->Far = zfar * 0.0254;
+			}
+
+			return v;
+		};
+	};
+
+
+}
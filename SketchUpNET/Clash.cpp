@@ -0,0 +1,360 @@
+/*
+
+SketchUpNET - a C++ Wrapper for the Trimble(R) SketchUp(R) C API
+Copyright(C) 2015, Autor: Maximilian Thumfart
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <vector>
+#include <map>
+#include <cmath>
+#include <algorithm>
+#include "utilities.h"
+#include "Transform.h"
+#include "Component.h"
+
+using namespace System;
+using namespace System::Collections;
+using namespace System::Collections::Generic;
+
+namespace SketchUpNET
+{
+	struct ClashMesh
+	{
+		std::vector<double> Positions;
+		std::vector<int> Indices;
+		double Min[3];
+		double Max[3];
+	};
+
+	struct ClashPair
+	{
+		int First;
+		int Second;
+		const ClashMesh* FirstMesh;
+		const ClashMesh* SecondMesh;
+		double FirstTransform[16];
+		double SecondTransform[16];
+		bool Clashes;
+		double Penetration;
+	};
+
+	/// <summary>
+	/// Triangle against triangle tests of one candidate pair, in the local space of the first instance
+	/// </summary>
+	struct ClashKernel
+	{
+		ClashPair* Pairs;
+		double Tolerance;
+
+		void operator()(int index) const
+		{
+			ClashPair& pair = Pairs[index];
+			pair.Clashes = false;
+			pair.Penetration = 0;
+
+			double inverse[16], relative[16];
+			if (!TransformMath::Invert(pair.FirstTransform, inverse)) return;
+			TransformMath::Multiply(inverse, pair.SecondTransform, relative);
+
+			const ClashMesh& a = *pair.FirstMesh;
+			const ClashMesh& b = *pair.SecondMesh;
+
+			// Tolerance is given in meters, tests run in the local space of the first instance
+			double scale = pow(fabs(TransformMath::Determinant(pair.FirstTransform)), 1.0 / 3.0);
+			double tolerance = (scale > 0) ? Tolerance / scale : Tolerance;
+
+			std::vector<double> second(b.Positions.size());
+			double secondMin[3], secondMax[3];
+			for (size_t i = 0; i < second.size(); i = i + 3)
+			{
+				TransformMath::TransformPoint(relative, &b.Positions[i], &second[i]);
+				Extend(&second[i], secondMin, secondMax, i == 0);
+			}
+			if (second.empty()) return;
+
+			// Only triangles within the overlap of both boxes can intersect, flat meshes such as panels give flat overlaps
+			double overlapMin[3], overlapMax[3];
+			for (int k = 0; k < 3; k++)
+			{
+				overlapMin[k] = (std::max)(a.Min[k], secondMin[k]);
+				overlapMax[k] = (std::min)(a.Max[k], secondMax[k]);
+				if (overlapMax[k] < overlapMin[k] - tolerance) return;
+
+				overlapMin[k] -= tolerance;
+				overlapMax[k] += tolerance;
+			}
+
+			std::vector<int> first, other;
+			Filter(a.Positions, a.Indices, overlapMin, overlapMax, first);
+			Filter(second, b.Indices, overlapMin, overlapMax, other);
+
+			double hitsMin[2][3], hitsMax[2][3];
+			bool hit = false;
+			for (size_t i = 0; i < first.size(); i++)
+			{
+				const double* p[3];
+				Corners(a.Positions, a.Indices, first[i], p);
+				for (size_t j = 0; j < other.size(); j++)
+				{
+					const double* q[3];
+					Corners(second, b.Indices, other[j], q);
+					if (!Intersects(p, q, tolerance)) continue;
+
+					for (int k = 0; k < 3; k++)
+					{
+						Extend(p[k], hitsMin[0], hitsMax[0], !hit && k == 0);
+						Extend(q[k], hitsMin[1], hitsMax[1], !hit && k == 0);
+					}
+					hit = true;
+				}
+			}
+			if (!hit) return;
+
+			// Smallest overlap of the intersecting triangles of both sides, scaled back to world units.
+			// Axes along which one side is flat, e.g. the normal of a panel, don't limit the depth.
+			double depth = -1;
+			for (int k = 0; k < 3; k++)
+			{
+				if (hitsMax[0][k] - hitsMin[0][k] <= tolerance || hitsMax[1][k] - hitsMin[1][k] <= tolerance) continue;
+				double extent = (std::min)(hitsMax[0][k], hitsMax[1][k]) - (std::max)(hitsMin[0][k], hitsMin[1][k]);
+				if (depth < 0 || extent < depth) depth = extent;
+			}
+
+			pair.Clashes = true;
+			pair.Penetration = (std::max)(0.0, depth) * scale;
+		}
+
+		static void Extend(const double* p, double* min, double* max, bool first)
+		{
+			for (int k = 0; k < 3; k++)
+			{
+				if (first || p[k] < min[k]) min[k] = p[k];
+				if (first || p[k] > max[k]) max[k] = p[k];
+			}
+		}
+
+		static void Corners(const std::vector<double>& positions, const std::vector<int>& indices, int triangle, const double** p)
+		{
+			for (int k = 0; k < 3; k++)
+				p[k] = &positions[3 * indices[3 * triangle + k]];
+		}
+
+		static void Filter(const std::vector<double>& positions, const std::vector<int>& indices, const double* min, const double* max, std::vector<int>& result)
+		{
+			for (int t = 0; t < (int)(indices.size() / 3); t++)
+			{
+				const double* p[3];
+				Corners(positions, indices, t, p);
+				bool outside = false;
+				for (int k = 0; k < 3 && !outside; k++)
+				{
+					double low = (std::min)(p[0][k], (std::min)(p[1][k], p[2][k]));
+					double high = (std::max)(p[0][k], (std::max)(p[1][k], p[2][k]));
+					outside = high < min[k] || low > max[k];
+				}
+				if (!outside) result.push_back(t);
+			}
+		}
+
+		static void Cross(const double* u, const double* v, double* out)
+		{
+			out[0] = u[1] * v[2] - u[2] * v[1];
+			out[1] = u[2] * v[0] - u[0] * v[2];
+			out[2] = u[0] * v[1] - u[1] * v[0];
+		}
+
+		// Separating axis test, triangles only touching within the local tolerance don't intersect
+		static bool Intersects(const double** p, const double** q, double tolerance)
+		{
+			double pe[3][3], qe[3][3];
+			for (int i = 0; i < 3; i++)
+			{
+				for (int k = 0; k < 3; k++)
+				{
+					pe[i][k] = p[(i + 1) % 3][k] - p[i][k];
+					qe[i][k] = q[(i + 1) % 3][k] - q[i][k];
+				}
+			}
+
+			double axes[17][3];
+			int count = 0;
+			Cross(pe[0], pe[1], axes[count++]);
+			Cross(qe[0], qe[1], axes[count++]);
+			for (int i = 0; i < 3; i++)
+				for (int j = 0; j < 3; j++)
+					Cross(pe[i], qe[j], axes[count++]);
+			// In plane axes separate coplanar triangles
+			for (int i = 0; i < 3; i++)
+			{
+				Cross(axes[0], pe[i], axes[count++]);
+				Cross(axes[1], qe[i], axes[count++]);
+			}
+
+			for (int i = 0; i < count; i++)
+			{
+				const double* axis = axes[i];
+				double length = sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+				if (length < 1e-12) continue;
+
+				double pMin = 0, pMax = 0, qMin = 0, qMax = 0;
+				for (int k = 0; k < 3; k++)
+				{
+					double pd = (p[k][0] * axis[0] + p[k][1] * axis[1] + p[k][2] * axis[2]) / length;
+					double qd = (q[k][0] * axis[0] + q[k][1] * axis[1] + q[k][2] * axis[2]) / length;
+					if (k == 0 || pd < pMin) pMin = pd;
+					if (k == 0 || pd > pMax) pMax = pd;
+					if (k == 0 || qd < qMin) qMin = qd;
+					if (k == 0 || qd > qMax) qMax = qd;
+				}
+				if (pMax <= qMin + tolerance || qMax <= pMin + tolerance) return false;
+			}
+			return true;
+		}
+	};
+
+	/// <summary>
+	/// Intersection between the meshes of two component instances
+	/// </summary>
+	public ref class Clash
+	{
+	public:
+		/// <summary>
+		/// Guid of the first instance
+		/// </summary>
+		System::String^ First;
+
+		/// <summary>
+		/// Guid of the second instance
+		/// </summary>
+		System::String^ Second;
+
+		/// <summary>
+		/// Estimated penetration depth in meters, the smallest extent of the overlap of the intersecting triangles
+		/// </summary>
+		double Penetration;
+
+		Clash(System::String^ first, System::String^ second, double penetration)
+		{
+			this->First = first;
+			this->Second = second;
+			this->Penetration = penetration;
+		};
+
+		Clash(){};
+
+		/// <summary>
+		/// Finds intersecting instances. A sweep and prune over world bounding boxes finds candidate pairs,
+		/// their definition meshes are then tested triangle against triangle across threads.
+		/// Touching faces and instances fully enclosed by another one without crossing faces are not reported.
+		/// Requires a model loaded including meshes, instance transformations must share one parent, e.g. SketchUp.Instances.
+		/// </summary>
+		/// <param name="instances">Instances to test against each other</param>
+		/// <param name="differentLayersOnly">Only test instances on different layers, e.g. ductwork against structure</param>
+		/// <param name="tolerance">Overlaps up to this distance in meters count as touching</param>
+		static List<Clash^>^ Detect(List<Instance^>^ instances, bool differentLayersOnly, double tolerance)
+		{
+			// Native mesh and bounds per definition, shared by its instances
+			std::vector<ClashMesh> meshes(instances->Count);
+			Dictionary<Component^, int>^ meshIndex = gcnew Dictionary<Component^, int>();
+			std::vector<int> instanceMesh(instances->Count, -1);
+			std::vector<double> transforms(16 * instances->Count);
+			int meshCount = 0;
+
+			for (int i = 0; i < instances->Count; i++)
+			{
+				Component^ component = dynamic_cast<Component^>(instances[i]->Parent);
+				if (component == nullptr || component->MergedMesh == nullptr || component->MergedMesh->TriangleCount == 0) continue;
+
+				if (!meshIndex->ContainsKey(component))
+				{
+					ClashMesh& mesh = meshes[meshCount];
+					Utilities::FromArray(component->MergedMesh->Positions, mesh.Positions);
+					Utilities::FromArray(component->MergedMesh->Indices, mesh.Indices);
+					for (size_t p = 0; p < mesh.Positions.size(); p = p + 3)
+						ClashKernel::Extend(&mesh.Positions[p], mesh.Min, mesh.Max, p == 0);
+					meshIndex->Add(component, meshCount++);
+				}
+
+				instanceMesh[i] = meshIndex[component];
+				instances[i]->Transformation->CopyTo(&transforms[16 * i]);
+			}
+
+			// World bounding boxes from the transformed corners of the definition bounds
+			std::vector<double> boxes(6 * instances->Count, 0.0);
+			std::vector<std::pair<double, int> > order;
+			for (int i = 0; i < instances->Count; i++)
+			{
+				if (instanceMesh[i] < 0) continue;
+				const ClashMesh& mesh = meshes[instanceMesh[i]];
+				for (int c = 0; c < 8; c++)
+				{
+					double corner[3] = { (c & 1) ? mesh.Max[0] : mesh.Min[0], (c & 2) ? mesh.Max[1] : mesh.Min[1], (c & 4) ? mesh.Max[2] : mesh.Min[2] };
+					double world[3];
+					TransformMath::TransformPoint(&transforms[16 * i], corner, world);
+					ClashKernel::Extend(world, &boxes[6 * i], &boxes[6 * i + 3], c == 0);
+				}
+				order.push_back(std::make_pair(boxes[6 * i], i));
+			}
+
+			// Sweep and prune along x
+			std::sort(order.begin(), order.end());
+			std::vector<ClashPair> pairs;
+			for (size_t i = 0; i < order.size(); i++)
+			{
+				int a = order[i].second;
+				for (size_t j = i + 1; j < order.size() && order[j].first <= boxes[6 * a + 3]; j++)
+				{
+					int b = order[j].second;
+					if (boxes[6 * b + 1] > boxes[6 * a + 4] || boxes[6 * a + 1] > boxes[6 * b + 4]) continue;
+					if (boxes[6 * b + 2] > boxes[6 * a + 5] || boxes[6 * a + 2] > boxes[6 * b + 5]) continue;
+					if (differentLayersOnly && System::String::Equals(instances[a]->Layer, instances[b]->Layer)) continue;
+
+					ClashPair pair;
+					pair.First = a;
+					pair.Second = b;
+					pair.FirstMesh = &meshes[instanceMesh[a]];
+					pair.SecondMesh = &meshes[instanceMesh[b]];
+					std::copy(&transforms[16 * a], &transforms[16 * a] + 16, pair.FirstTransform);
+					std::copy(&transforms[16 * b], &transforms[16 * b] + 16, pair.SecondTransform);
+					pairs.push_back(pair);
+				}
+			}
+
+			if (!pairs.empty())
+			{
+				ClashKernel kernel;
+				kernel.Pairs = &pairs[0];
+				kernel.Tolerance = tolerance;
+				Utilities::ParallelFor((int)pairs.size(), kernel);
+			}
+
+			List<Clash^>^ clashes = gcnew List<Clash^>();
+			for (size_t i = 0; i < pairs.size(); i++)
+			{
+				if (!pairs[i].Clashes) continue;
+				clashes->Add(gcnew Clash(instances[pairs[i].First]->Guid, instances[pairs[i].Second]->Guid, pairs[i].Penetration));
+			}
+
+			return clashes;
+		}
+	};
+
+
+}
@@ -37,9 +37,15 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "edge.h"
 #include "group.h"
 #include "curve.h"
+#include "ArcTable.h"
+#include "Annotations.h"
+#include "Image.h"
+#include "Opening.h"
 #include "utilities.h"
 #include "Transform.h"
 #include "Instance.h"
+#include "MeshBatch.h"
+#include "Solid.h"
 
 using namespace System;
 using namespace System::Collections;
@@ -58,6 +64,40 @@ namespace SketchUpNET
 		List<Curve^>^ Curves;
 		List<Edge^>^ Edges;
 		List<Group^>^ Groups;
+		Int64 PersistentId;
+
+		/// <summary>
+		/// All faces of this definition, including nested groups and instances, merged into a single local space mesh.
+		/// Only available if the model has been loaded including meshes.
+		/// </summary>
+		MeshBatch^ MergedMesh;
+
+		/// <summary>
+		/// Closure and volume of this definition in local coordinates.
+		/// Only available if the model has been loaded with AnalyzeSolids.
+		/// </summary>
+		SketchUpNET::Solid^ Solid;
+
+		/// <summary>
+		/// Arcs and circles of this definition, only available if the model has been loaded with ArcsAsTable
+		/// </summary>
+		ArcTable^ Arcs;
+
+		/// <summary>
+		/// Guides, polylines, texts and dimensions of this definition, only available if the model has been loaded with Annotations
+		/// </summary>
+		AnnotationTable^ Annotations;
+
+		/// <summary>
+		/// Image entities of this definition, pixels can be read through a ModelSession
+		/// </summary>
+		List<Image^>^ Images;
+
+		/// <summary>
+		/// Openings this definition cuts into the face it is glued to, in local coordinates.
+		/// Only available if the model has been loaded with Openings.
+		/// </summary>
+		PointRings^ Openings;
 
 		Component(System::String^ name, System::String^ guid, List<Surface^>^ surfaces, List<Curve^>^ curves, List<Edge^>^ edges, List<Instance^>^ instances, System::String^ desc, List<Group^>^ groups)
 		{
@@ -72,8 +112,53 @@ namespace SketchUpNET
 		};
 
 		Component(){};
+
+		/// <summary>
+		/// Returns the merged mesh of an instance's definition transformed into world space
+		/// </summary>
+		/// <param name="instance">Instance of a component loaded including meshes</param>
+		static MeshBatch^ GetWorldMesh(Instance^ instance)
+		{
+			List<Instance^>^ instances = gcnew List<Instance^>();
+			instances->Add(instance);
+			return GetWorldMesh(instances);
+		}
+
+		/// <summary>
+		/// Returns the merged meshes of many instances transformed into world space as a single mesh
+		/// </summary>
+		/// <param name="instances">Instances of components loaded including meshes</param>
+		static MeshBatch^ GetWorldMesh(List<Instance^>^ instances)
+		{
+			List<MeshBatch^>^ batches = gcnew List<MeshBatch^>();
+			List<Transform^>^ transformations = gcnew List<Transform^>();
+
+			for each (Instance^ instance in instances)
+			{
+				Component^ parent = dynamic_cast<Component^>(instance->Parent);
+				if (parent == nullptr || parent->MergedMesh == nullptr) continue;
+
+				batches->Add(parent->MergedMesh);
+				transformations->Add(instance->Transformation);
+			}
+
+			return MeshBatch::Merge(batches, transformations);
+		}
+
+		/// <summary>
+		/// Returns closure and volume of an instance's definition scaled by the instance transformation
+		/// </summary>
+		/// <param name="instance">Instance of a component loaded with AnalyzeSolids</param>
+		static SketchUpNET::Solid^ GetSolid(Instance^ instance)
+		{
+			Component^ parent = dynamic_cast<Component^>(instance->Parent);
+			if (parent == nullptr || parent->Solid == nullptr) return nullptr;
+
+			return parent->Solid->Transformed(instance->Transformation);
+		}
+
 	internal:
-		static Component^ FromSU(SUComponentDefinitionRef comp, bool includeMeshes, System::Collections::Generic::Dictionary<String^, Material^>^ materials)
+		static Component^ FromSU(SUComponentDefinitionRef comp, LoadContext^ context, System::Collections::Generic::Dictionary<String^, Material^>^ materials)
 		{
 			SUStringRef name = SU_INVALID;
 			SUStringCreate(&name);
@@ -94,16 +179,32 @@ namespace SketchUpNET
 			SUStringCreate(&guid);
 			SUComponentDefinitionGetGuid(comp, &guid);
 
-			List<Surface^>^ surfaces = Surface::GetEntitySurfaces(entities, includeMeshes, materials);
-			List<Curve^>^ curves = Curve::GetEntityCurves(entities);
-			List<Edge^>^ edges = Edge::GetEntityEdges(entities);
-			List<Instance^>^ instances = Instance::GetEntityInstances(entities, materials);
-			List<Group^>^ grps = Group::GetEntityGroups(entities, includeMeshes, materials);
+			List<Surface^>^ surfaces = Surface::GetEntitySurfaces(entities, context, materials);
+			List<Curve^>^ curves = Curve::GetEntityCurves(entities, context);
+			List<Edge^>^ edges = Edge::GetEntityEdges(entities, context);
+			List<Instance^>^ instances = Instance::GetEntityInstances(entities, context, materials);
+			List<Group^>^ grps = Group::GetEntityGroups(entities, context, materials);
 			
 			
 
 			Component^ v = gcnew Component(Utilities::GetString(name), Utilities::GetString(guid), surfaces, curves, edges,instances, Utilities::GetString(desc), grps);
 
+			if (context->Options->ArcsAsTable)
+				v->Arcs = ArcTable::FromEntities(entities, context);
+
+			v->Images = Image::GetEntityImages(entities, context);
+
+			if (context->Options->Openings)
+				v->Openings = Opening::FromDefinition(comp);
+
+			if (context->Options->Annotations != AnnotationKinds::None)
+				v->Annotations = AnnotationTable::FromEntities(entities, context);
+
+			v->PersistentId = Utilities::GetPersistentId(SUComponentDefinitionToEntity(comp));
+
+			if (context->Options->IncludeMeshes)
+				v->MergedMesh = MeshBatch::FromEntities(entities, v->Name, context, materials);
+
 			return v;
 		};
 
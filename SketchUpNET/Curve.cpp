@@ -34,6 +34,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include <msclr/marshal.h>
 #include <vector>
 #include "edge.h"
+#include "LoadContext.h"
 
 using namespace System;
 using namespace System::Collections;
@@ -124,7 +125,18 @@ namespace SketchUpNET
 			return result;
 		}
 
-		static List<Curve^>^ GetEntityCurves(SUEntitiesRef entities)
+		/// <summary>
+		/// Curves share the visibility of their edges
+		/// </summary>
+		static bool IsVisible(SUCurveRef curve, LoadContext^ context)
+		{
+			SUEdgeRef edge = SU_INVALID;
+			size_t count = 0;
+			SUCurveGetEdges(curve, 1, &edge, &count);
+			return count == 0 || context->IsVisible(SUEdgeToDrawingElement(edge));
+		}
+
+		static List<Curve^>^ GetEntityCurves(SUEntitiesRef entities, LoadContext^ context)
 		{
 			List<Curve^>^ curves = gcnew List<Curve^>();
 
@@ -138,6 +150,15 @@ namespace SketchUpNET
 
 
 				for (size_t i = 0; i < curveCount; i++) {
+					if (!IsVisible(curvevector[i], context)) continue;
+
+					if (context->Options->ArcsAsTable)
+					{
+						SUCurveType type = SUCurveType::SUCurveType_Simple;
+						SUCurveGetType(curvevector[i], &type);
+						if (type == SUCurveType::SUCurveType_Arc) continue;
+					}
+
 					Curve^ curve = Curve::FromSU(curvevector[i]);
 					curves->Add(curve);
 				}
@@ -36,6 +36,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include <vector>
 #include "vertex.h"
 #include "utilities.h"
+#include "LoadContext.h"
 
 using namespace System;
 using namespace System::Collections;
@@ -50,6 +51,12 @@ namespace SketchUpNET
 		Vertex^ Start;
 		Vertex^ End;
 		System::String^ Layer;
+		Int64 PersistentId;
+
+		/// <summary>
+		/// Soft, smooth and hidden bits of the edge
+		/// </summary>
+		EdgeFlags Flags;
 
 		/// <summary>
 		/// Creates a new edge by startpoint, endpoint and layer name
@@ -99,10 +106,26 @@ namespace SketchUpNET
 			}
 			
 			Edge^ v = gcnew Edge(Vertex::FromSU(start), Vertex::FromSU(end), layername);
+			v->PersistentId = Utilities::GetPersistentId(SUEdgeToEntity(edge));
+			v->Flags = GetFlags(edge);
 
 			return v;
 		};
 
+		static EdgeFlags GetFlags(SUEdgeRef edge)
+		{
+			bool soft = false, smooth = false, hidden = false;
+			SUEdgeGetSoft(edge, &soft);
+			SUEdgeGetSmooth(edge, &smooth);
+			SUDrawingElementGetHidden(SUEdgeToDrawingElement(edge), &hidden);
+
+			EdgeFlags flags = EdgeFlags::None;
+			if (soft) flags = flags | EdgeFlags::Soft;
+			if (smooth) flags = flags | EdgeFlags::Smooth;
+			if (hidden) flags = flags | EdgeFlags::Hidden;
+			return flags;
+		}
+
 		SUEdgeRef ToSU()
 		{
 			SUEdgeRef edge = SU_INVALID;
@@ -123,7 +146,7 @@ namespace SketchUpNET
 			return result;
 		}
 
-		static List<Edge^>^ GetEntityEdges(SUEntitiesRef entities)
+		static List<Edge^>^ GetEntityEdges(SUEntitiesRef entities, LoadContext^ context)
 		{
 			List<Edge^>^ edges = gcnew List<Edge^>();
 
@@ -138,6 +161,17 @@ namespace SketchUpNET
 
 
 				for (size_t i = 0; i < edgeCount; i++) {
+					if (context->Options->SkipEdges != EdgeFlags::None && (GetFlags(edgevector[i]) & context->Options->SkipEdges) != EdgeFlags::None) continue;
+					if (!context->IsVisible(SUEdgeToDrawingElement(edgevector[i]))) continue;
+
+					// Edges of arcs are already held analytically by the ArcTable
+					if (context->Options->ArcsAsTable)
+					{
+						SUCurveRef curve = SU_INVALID;
+						SUCurveType type = SUCurveType::SUCurveType_Simple;
+						if (SUEdgeGetCurve(edgevector[i], &curve) == SU_ERROR_NONE && SUCurveGetType(curve, &type) == SU_ERROR_NONE && type == SUCurveType::SUCurveType_Arc) continue;
+					}
+
 					Edge^ edge = Edge::FromSU(edgevector[i]);
 					edges->Add(edge);
 				}
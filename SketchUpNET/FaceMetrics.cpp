@@ -0,0 +1,228 @@
+/*
+
+SketchUpNET - a C++ Wrapper for the Trimble(R) SketchUp(R) C API
+Copyright(C) 2015, Autor: Maximilian Thumfart
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <vector>
+#include <cmath>
+#include "surface.h"
+#include "utilities.h"
+#include "Triangulator.h"
+
+using namespace System;
+using namespace System::Collections;
+using namespace System::Collections::Generic;
+
+namespace SketchUpNET
+{
+	/// <summary>
+	/// Computes the metrics of one face of a batch from its outer and inner rings
+	/// </summary>
+	struct FaceMetricsKernel
+	{
+		const double* Points;
+		const int* RingOffsets;
+		const int* FaceRings;
+		double* Centroids;
+		double* Normals;
+		double* Planes;
+		double* Areas;
+		double* BoundsMin;
+		double* BoundsMax;
+
+		void operator()(int face) const
+		{
+			const int* offsets = &RingOffsets[FaceRings[face]];
+			int ringCount = FaceRings[face + 1] - FaceRings[face];
+
+			double* centroid = &Centroids[3 * face];
+			double* normal = &Normals[3 * face];
+			double* plane = &Planes[4 * face];
+			double* min = &BoundsMin[3 * face];
+			double* max = &BoundsMax[3 * face];
+
+			for (int j = 0; j < 3; j++)
+			{
+				centroid[j] = normal[j] = min[j] = max[j] = 0;
+				plane[j] = 0;
+			}
+			plane[3] = 0;
+			Areas[face] = 0;
+
+			if (ringCount < 1 || offsets[1] - offsets[0] < 1) return;
+
+			// Bounds of the outer ring, holes lie inside
+			for (int j = 0; j < 3; j++)
+				min[j] = max[j] = Points[3 * offsets[0] + j];
+			for (int i = offsets[0] + 1; i < offsets[1]; i++)
+			{
+				for (int j = 0; j < 3; j++)
+				{
+					double value = Points[3 * i + j];
+					if (value < min[j]) min[j] = value;
+					if (value > max[j]) max[j] = value;
+				}
+			}
+
+			PolygonTriangulator::Newell(Points, offsets[0], offsets[1], normal);
+			double length = sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+			if (length == 0)
+			{
+				// Degenerate face, fall back to the vertex average
+				int count = offsets[1] - offsets[0];
+				for (int i = offsets[0]; i < offsets[1]; i++)
+					for (int j = 0; j < 3; j++) centroid[j] += Points[3 * i + j] / count;
+				return;
+			}
+			for (int j = 0; j < 3; j++) normal[j] /= length;
+
+			// Fan triangles of every ring weighted by their signed area along the normal,
+			// outer ring added and holes subtracted regardless of their winding
+			double area = 0;
+			double weighted[3] = { 0, 0, 0 };
+			for (int r = 0; r < ringCount; r++)
+			{
+				double ringArea = 0;
+				double ringWeighted[3] = { 0, 0, 0 };
+				const double* a = &Points[3 * offsets[r]];
+				for (int i = offsets[r] + 1; i + 1 < offsets[r + 1]; i++)
+				{
+					const double* b = &Points[3 * i];
+					const double* c = &Points[3 * (i + 1)];
+					double u[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+					double v[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+					double triangleArea = 0.5 * ((u[1] * v[2] - u[2] * v[1]) * normal[0] + (u[2] * v[0] - u[0] * v[2]) * normal[1] + (u[0] * v[1] - u[1] * v[0]) * normal[2]);
+
+					ringArea += triangleArea;
+					for (int j = 0; j < 3; j++)
+						ringWeighted[j] += triangleArea * (a[j] + b[j] + c[j]) / 3.0;
+				}
+
+				double sign = ((ringArea < 0) == (r == 0)) ? -1.0 : 1.0;
+				area += sign * ringArea;
+				for (int j = 0; j < 3; j++) weighted[j] += sign * ringWeighted[j];
+			}
+
+			Areas[face] = area;
+			for (int j = 0; j < 3; j++)
+				centroid[j] = (area != 0) ? weighted[j] / area : 0;
+
+			plane[0] = normal[0];
+			plane[1] = normal[1];
+			plane[2] = normal[2];
+			plane[3] = -(normal[0] * centroid[0] + normal[1] * centroid[1] + normal[2] * centroid[2]);
+		}
+	};
+
+	/// <summary>
+	/// Area, 3D centroid, normal, plane and bounds of many faces stored in flat buffers.
+	/// Values of face i start at i * 3, or at i * 4 for planes.
+	/// </summary>
+	public ref class FaceMetrics
+	{
+	public:
+		/// <summary>
+		/// Area weighted centroids as x,y,z triplets
+		/// </summary>
+		array<double>^ Centroids;
+
+		/// <summary>
+		/// Unit Newell normals of the outer loops as x,y,z triplets
+		/// </summary>
+		array<double>^ Normals;
+
+		/// <summary>
+		/// Plane equations a,b,c,d with a*x + b*y + c*z + d = 0
+		/// </summary>
+		array<double>^ Planes;
+
+		/// <summary>
+		/// Face areas without holes
+		/// </summary>
+		array<double>^ Areas;
+
+		/// <summary>
+		/// Lower corners of the axis aligned bounding boxes as x,y,z triplets
+		/// </summary>
+		array<double>^ BoundsMin;
+
+		/// <summary>
+		/// Upper corners of the axis aligned bounding boxes as x,y,z triplets
+		/// </summary>
+		array<double>^ BoundsMax;
+
+		property int Count
+		{
+			int get() { return (Areas == nullptr) ? 0 : Areas->Length; }
+		}
+
+		FaceMetrics(){};
+
+		/// <summary>
+		/// Computes the metrics of all surfaces across threads.
+		/// Loops are read from point rings if the model has been loaded with LoopsAsPoints.
+		/// </summary>
+		/// <param name="surfaces">Surfaces, e.g. of a loaded model</param>
+		static FaceMetrics^ Compute(List<Surface^>^ surfaces)
+		{
+			std::vector<double> points;
+			std::vector<int> ringOffsets(1, 0);
+			std::vector<int> faceRings;
+			faceRings.reserve(surfaces->Count + 1);
+
+			for each (Surface^ surface in surfaces)
+			{
+				faceRings.push_back((int)ringOffsets.size() - 1);
+				surface->AppendRings(points, ringOffsets);
+			}
+			faceRings.push_back((int)ringOffsets.size() - 1);
+
+			int count = surfaces->Count;
+			std::vector<double> centroids(3 * count), normals(3 * count), planes(4 * count), areas(count), boundsMin(3 * count), boundsMax(3 * count);
+
+			if (count > 0 && !points.empty())
+			{
+				FaceMetricsKernel kernel;
+				kernel.Points = &points[0];
+				kernel.RingOffsets = &ringOffsets[0];
+				kernel.FaceRings = &faceRings[0];
+				kernel.Centroids = &centroids[0];
+				kernel.Normals = &normals[0];
+				kernel.Planes = &planes[0];
+				kernel.Areas = &areas[0];
+				kernel.BoundsMin = &boundsMin[0];
+				kernel.BoundsMax = &boundsMax[0];
+				Utilities::ParallelFor(count, kernel);
+			}
+
+			FaceMetrics^ v = gcnew FaceMetrics();
+			v->Centroids = Utilities::ToArray(centroids);
+			v->Normals = Utilities::ToArray(normals);
+			v->Planes = Utilities::ToArray(planes);
+			v->Areas = Utilities::ToArray(areas);
+			v->BoundsMin = Utilities::ToArray(boundsMin);
+			v->BoundsMax = Utilities::ToArray(boundsMax);
+			return v;
+		}
+	};
+
+
+}
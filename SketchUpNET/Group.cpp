@@ -31,13 +31,18 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include <SketchUpAPI/model/vertex.h>
 #include <SketchUpAPI/model/layer.h>
 #include <SketchUpAPI/model/group.h>
+#include <SketchUpAPI/model/component_definition.h>
 #include "utilities.h"
 #include <msclr/marshal.h>
 #include <vector>
 #include "Surface.h"
 #include "Edge.h"
 #include "curve.h"
+#include "ArcTable.h"
+#include "Annotations.h"
+#include "Image.h"
 #include "Instance.h"
+#include "Solid.h"
 
 using namespace System;
 using namespace System::Collections;
@@ -45,6 +50,8 @@ using namespace System::Collections::Generic;
 
 namespace SketchUpNET
 {
+	ref class Component;
+
 	public ref class Group
 	{
 	public:
@@ -58,6 +65,39 @@ namespace SketchUpNET
 		SketchUpNET::Material^ Material;
 		System::String^ Layer;
 		System::String^ Guid;
+		Int64 PersistentId;
+
+		/// <summary>
+		/// Guid of the group definition shared by all copies of this group, see SketchUp.GroupDefinitions
+		/// </summary>
+		System::String^ DefinitionGuid;
+
+		/// <summary>
+		/// Group definition holding the contents in local coordinates, null if the group has been read on its own.
+		/// Surfaces, Edges, Curves, Instances, Groups, Arcs, Annotations and Images refer to the lists of the definition.
+		/// </summary>
+		Component^ Definition;
+
+		/// <summary>
+		/// Closure and volume of this group in local coordinates, see Solid::Transformed.
+		/// Only available if the model has been loaded with AnalyzeSolids.
+		/// </summary>
+		SketchUpNET::Solid^ Solid;
+
+		/// <summary>
+		/// Arcs and circles of this group, only available if the model has been loaded with ArcsAsTable
+		/// </summary>
+		ArcTable^ Arcs;
+
+		/// <summary>
+		/// Guides, polylines, texts and dimensions of this group, only available if the model has been loaded with Annotations
+		/// </summary>
+		AnnotationTable^ Annotations;
+
+		/// <summary>
+		/// Image entities of this group, pixels can be read through a ModelSession
+		/// </summary>
+		List<Image^>^ Images;
 
 		Group(System::String^ name, List<Surface^>^ surfaces, List<Curve^>^ curves, List<Edge^>^ edges, List<Instance^>^ insts, List<Group^>^ group, Transform^ transformation, System::String^ layername, SketchUpNET::Material^ mat, System::String^ guid)
 		{
@@ -75,7 +115,7 @@ namespace SketchUpNET
 
 		Group(){};
 	internal:
-		static Group^ FromSU(SUGroupRef group, bool includeMeshes, System::Collections::Generic::Dictionary<String^, SketchUpNET::Material^>^ materials)
+		static Group^ FromSU(SUGroupRef group, LoadContext^ context, System::Collections::Generic::Dictionary<String^, SketchUpNET::Material^>^ materials)
 		{
 			SUStringRef name = SU_INVALID;
 			SUStringCreate(&name);
@@ -103,12 +143,6 @@ namespace SketchUpNET
 			SUTransformation transform = SU_INVALID;
 			SUGroupGetTransform(group, &transform);
 			
-			List<Surface^>^ surfaces = Surface::GetEntitySurfaces(entities, includeMeshes, materials);
-			List<Edge^>^ edges = Edge::GetEntityEdges(entities);
-			List<Curve^>^ curves = Curve::GetEntityCurves(entities);
-			List<Instance^>^ inst = Instance::GetEntityInstances(entities, materials);
-			List<Group^>^ grps = Group::GetEntityGroups(entities, includeMeshes, materials);
-			
 			// Layer
 			SULayerRef layer = SU_INVALID;
 			SUDrawingElementGetLayer(SUGroupToDrawingElement(group), &layer);
@@ -119,12 +153,49 @@ namespace SketchUpNET
 				layername = SketchUpNET::Utilities::GetLayerName(layer);
 			}
 
-			Group^ v = gcnew Group(SketchUpNET::Utilities::GetString(name), surfaces, curves, edges, inst, grps, Transform::FromSU(transform), layername, groupMat, SketchUpNET::Utilities::GetString(guid));
+			SUComponentDefinitionRef definition = SU_INVALID;
+			SUGroupGetDefinition(group, &definition);
+
+			Group^ v = nullptr;
+			if (context->GroupDefinitions != nullptr && !SUIsInvalid(definition))
+			{
+				// Contents are read once per definition and shared by all copies, see SketchUp::LoadGroupDefinitions
+				if (context->GroupDefinitions->Add(IntPtr(definition.ptr)))
+					context->PendingGroupDefinitions->Add(IntPtr(definition.ptr));
+
+				v = gcnew Group(SketchUpNET::Utilities::GetString(name), nullptr, nullptr, nullptr, nullptr, nullptr, Transform::FromSU(transform), layername, groupMat, SketchUpNET::Utilities::GetString(guid));
+
+				SUStringRef definitionGuid = SU_INVALID;
+				SUStringCreate(&definitionGuid);
+				SUComponentDefinitionGetGuid(definition, &definitionGuid);
+				v->DefinitionGuid = SketchUpNET::Utilities::GetString(definitionGuid);
+				SUStringRelease(&definitionGuid);
+			}
+			else
+			{
+				List<Surface^>^ surfaces = Surface::GetEntitySurfaces(entities, context, materials);
+				List<Edge^>^ edges = Edge::GetEntityEdges(entities, context);
+				List<Curve^>^ curves = Curve::GetEntityCurves(entities, context);
+				List<Instance^>^ inst = Instance::GetEntityInstances(entities, context, materials);
+				List<Group^>^ grps = Group::GetEntityGroups(entities, context, materials);
+
+				v = gcnew Group(SketchUpNET::Utilities::GetString(name), surfaces, curves, edges, inst, grps, Transform::FromSU(transform), layername, groupMat, SketchUpNET::Utilities::GetString(guid));
+
+				if (context->Options->ArcsAsTable)
+					v->Arcs = ArcTable::FromEntities(entities, context);
+
+				v->Images = Image::GetEntityImages(entities, context);
+
+				if (context->Options->Annotations != AnnotationKinds::None)
+					v->Annotations = AnnotationTable::FromEntities(entities, context);
+			}
+
+			v->PersistentId = Utilities::GetPersistentId(SUGroupToEntity(group));
 
 			return v;
 		};
 
-		static List<Group^>^ GetEntityGroups(SUEntitiesRef entities, bool includeMeshes, System::Collections::Generic::Dictionary<String^, SketchUpNET::Material^>^ materials)
+		static List<Group^>^ GetEntityGroups(SUEntitiesRef entities, LoadContext^ context, System::Collections::Generic::Dictionary<String^, SketchUpNET::Material^>^ materials)
 		{
 			List<Group^>^ groups = gcnew List<Group^>();
 
@@ -136,7 +207,10 @@ namespace SketchUpNET
 				SUEntitiesGetGroups(entities, instanceCount, &instances[0], &instanceCount);
 
 				for (size_t i = 0; i < instanceCount; i++) {
-					Group^ inst = Group::FromSU(instances[i], includeMeshes, materials);
+					// Hidden groups are skipped before their contents are read
+					if (!context->IsVisible(SUGroupToDrawingElement(instances[i]))) continue;
+
+					Group^ inst = Group::FromSU(instances[i], context, materials);
 					groups->Add(inst);
 				}
 
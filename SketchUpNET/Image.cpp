@@ -0,0 +1,236 @@
+/*
+
+SketchUpNET - a C++ Wrapper for the Trimble(R) SketchUp(R) C API
+Copyright(C) 2015, Autor: Maximilian Thumfart
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+#pragma once
+
+#include <SketchUpAPI/slapi.h>
+#include <SketchUpAPI/geometry.h>
+#include <SketchUpAPI/transformation.h>
+#include <SketchUpAPI/unicodestring.h>
+#include <SketchUpAPI/model/entities.h>
+#include <SketchUpAPI/model/drawing_element.h>
+#include <SketchUpAPI/model/layer.h>
+#include <SketchUpAPI/model/image.h>
+#include <SketchUpAPI/model/image_rep.h>
+#include <vector>
+#include "utilities.h"
+#include "Transform.h"
+#include "LoadContext.h"
+
+using namespace System;
+using namespace System::Collections;
+using namespace System::Collections::Generic;
+
+namespace SketchUpNET
+{
+	/// <summary>
+	/// Decoded pixels of an image entity, see ModelSession.GetPixels
+	/// </summary>
+	public ref class ImagePixels
+	{
+	public:
+		int Width;
+		int Height;
+
+		/// <summary>
+		/// 24 (BGR) or 32 (BGRA)
+		/// </summary>
+		int BitsPerPixel;
+
+		/// <summary>
+		/// Padding bytes at the end of each row
+		/// </summary>
+		int RowPadding;
+
+		/// <summary>
+		/// Raw pixel rows as stored in the model
+		/// </summary>
+		array<Byte>^ Data;
+
+		/// <summary>
+		/// Content hash of Data, images with equal pixels share one ImagePixels instance
+		/// </summary>
+		UInt64 Hash;
+
+		ImagePixels(){};
+
+	internal:
+		/// <summary>
+		/// Copies the pixels of an image, returns null if it holds no data
+		/// </summary>
+		static ImagePixels^ FromSU(SUImageRef image)
+		{
+			SUImageRepRef rep = SU_INVALID;
+			SUImageRepCreate(&rep);
+			if (SUImageGetImageRep(image, &rep) != SU_ERROR_NONE)
+			{
+				SUImageRepRelease(&rep);
+				return nullptr;
+			}
+
+			size_t width = 0, height = 0, padding = 0, size = 0, bits = 0;
+			SUImageRepGetPixelDimensions(rep, &width, &height);
+			SUImageRepGetRowPadding(rep, &padding);
+			SUImageRepGetDataSize(rep, &size, &bits);
+
+			ImagePixels^ pixels = gcnew ImagePixels();
+			pixels->Width = (int)width;
+			pixels->Height = (int)height;
+			pixels->BitsPerPixel = (int)bits;
+			pixels->RowPadding = (int)padding;
+			pixels->Data = gcnew array<Byte>((int)size);
+			if (size > 0)
+			{
+				pin_ptr<Byte> data = &pixels->Data[0];
+				SUImageRepGetData(rep, size, data);
+				pixels->Hash = Hash(data, size);
+			}
+
+			SUImageRepRelease(&rep);
+			return pixels;
+		}
+
+		/// <summary>
+		/// 64 bit FNV-1a
+		/// </summary>
+		static UInt64 Hash(const unsigned char* data, size_t size)
+		{
+			unsigned long long hash = 14695981039346656037ULL;
+			for (size_t i = 0; i < size; i++)
+			{
+				hash ^= data[i];
+				hash *= 1099511628211ULL;
+			}
+			return hash;
+		}
+
+		bool SameContent(ImagePixels^ other)
+		{
+			if (Width != other->Width || Height != other->Height || BitsPerPixel != other->BitsPerPixel || Data->Length != other->Data->Length)
+				return false;
+
+			for (int i = 0; i < Data->Length; i++)
+			{
+				if (Data[i] != other->Data[i]) return false;
+			}
+			return true;
+		}
+	};
+
+	/// <summary>
+	/// Image entity placed in the model. Only metadata is read while loading,
+	/// pixels are decoded on request through ModelSession.GetPixels.
+	/// </summary>
+	public ref class Image
+	{
+	public:
+		System::String^ Name;
+
+		/// <summary>
+		/// Name of the file the image has been imported from
+		/// </summary>
+		System::String^ FileName;
+
+		/// <summary>
+		/// Placement of the image in the coordinates of its parent
+		/// </summary>
+		Transform^ Transformation;
+
+		/// <summary>
+		/// Size in pixels
+		/// </summary>
+		int PixelWidth;
+		int PixelHeight;
+
+		/// <summary>
+		/// Placed size in meters
+		/// </summary>
+		double Width;
+		double Height;
+
+		System::String^ Layer;
+		Int64 PersistentId;
+
+		Image(){};
+
+	internal:
+		static Image^ FromSU(SUImageRef image)
+		{
+			Image^ v = gcnew Image();
+
+			SUStringRef name = SU_INVALID;
+			SUStringCreate(&name);
+			SUImageGetName(image, &name);
+			v->Name = Utilities::GetString(name);
+			SUStringRelease(&name);
+
+			SUStringRef file = SU_INVALID;
+			SUStringCreate(&file);
+			SUImageGetFileName(image, &file);
+			v->FileName = Utilities::GetString(file);
+			SUStringRelease(&file);
+
+			SUTransformation transform;
+			SUImageGetTransform(image, &transform);
+			v->Transformation = Transform::FromSU(transform);
+
+			size_t pixelWidth = 0, pixelHeight = 0;
+			SUImageGetPixelDimensions(image, &pixelWidth, &pixelHeight);
+			v->PixelWidth = (int)pixelWidth;
+			v->PixelHeight = (int)pixelHeight;
+
+			double width = 0, height = 0;
+			SUImageGetDimensions(image, &width, &height);
+			v->Width = width * 0.0254;
+			v->Height = height * 0.0254;
+
+			v->Layer = System::String::Empty;
+			SULayerRef layer = SU_INVALID;
+			SUDrawingElementGetLayer(SUImageToDrawingElement(image), &layer);
+			if (!SUIsInvalid(layer))
+				v->Layer = Utilities::GetLayerName(layer);
+
+			v->PersistentId = Utilities::GetPersistentId(SUImageToEntity(image));
+			return v;
+		}
+
+		static List<Image^>^ GetEntityImages(SUEntitiesRef entities, LoadContext^ context)
+		{
+			List<Image^>^ images = gcnew List<Image^>();
+
+			size_t count = 0;
+			SUEntitiesGetNumImages(entities, &count);
+			if (count == 0) return images;
+
+			std::vector<SUImageRef> refs(count);
+			SUEntitiesGetImages(entities, count, &refs[0], &count);
+
+			for (size_t i = 0; i < count; i++)
+			{
+				if (!context->IsVisible(SUImageToDrawingElement(refs[i]))) continue;
+				images->Add(Image::FromSU(refs[i]));
+			}
+
+			return images;
+		}
+	};
+
+
+}
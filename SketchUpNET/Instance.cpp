@@ -37,6 +37,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "transform.h"
 #include "utilities.h"
 #include "Material.h"
+#include "LoadContext.h"
 
 using namespace System;
 using namespace System::Collections;
@@ -54,6 +55,12 @@ namespace SketchUpNET
 		System::Object^ Parent;
 		System::String^ Layer;
 		SketchUpNET::Material^ Material;
+		Int64 PersistentId;
+
+		/// <summary>
+		/// Row of this instance in SketchUp.InstanceInfo, -1 if loaded without Classifications or DynamicAttributes
+		/// </summary>
+		int InfoRow;
 
 		Instance(System::String^ name, System::String^ guid, String^ parent, Transform^ transformation, System::String^ layername, SketchUpNET::Material^ mat)
 		{
@@ -63,10 +70,14 @@ namespace SketchUpNET
 			this->Guid = guid;
 			this->Layer = layername;
 			this->Material = mat;
+			this->InfoRow = -1;
 		};
 
 
-		Instance(){};
+		Instance()
+		{
+			this->InfoRow = -1;
+		};
 	internal:
 		static Instance^ FromSU(SUComponentInstanceRef comp, System::Collections::Generic::Dictionary<String^, SketchUpNET::Material^>^ materials)
 		{
@@ -114,10 +125,11 @@ namespace SketchUpNET
 			
 
 			Instance^ v = gcnew Instance(SketchUpNET::Utilities::GetString(name), SketchUpNET::Utilities::GetString(instanceguid), parent, Transform::FromSU(transform), layername, groupMat);
+			v->PersistentId = Utilities::GetPersistentId(SUComponentInstanceToEntity(comp));
 
 			return v;
 		};
-		static List<Instance^>^ GetEntityInstances(SUEntitiesRef entities, System::Collections::Generic::Dictionary<String^, SketchUpNET::Material^>^ materials)
+		static List<Instance^>^ GetEntityInstances(SUEntitiesRef entities, LoadContext^ context, System::Collections::Generic::Dictionary<String^, SketchUpNET::Material^>^ materials)
 		{
 			List<Instance^>^ instancelist = gcnew List<Instance^>();
 
@@ -131,7 +143,10 @@ namespace SketchUpNET
 				SUEntitiesGetInstances(entities, instanceCount, &instances[0], &instanceCount);
 
 				for (size_t i = 0; i < instanceCount; i++) {
+					if (!context->IsVisible(SUComponentInstanceToDrawingElement(instances[i]))) continue;
+
 					Instance^ inst = Instance::FromSU(instances[i], materials);
+					inst->InfoRow = (context->InstanceInfo != nullptr) ? context->InstanceInfo->Read(instances[i]) : -1;
 					instancelist->Add(inst);
 				}
 
@@ -0,0 +1,313 @@
+/*
+
+SketchUpNET - a C++ Wrapper for the Trimble(R) SketchUp(R) C API
+Copyright(C) 2015, Autor: Maximilian Thumfart
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+#pragma once
+
+#include <SketchUpAPI/slapi.h>
+#include <SketchUpAPI/unicodestring.h>
+#include <SketchUpAPI/model/entity.h>
+#include <SketchUpAPI/model/component_instance.h>
+#include <SketchUpAPI/model/classification_info.h>
+#include <SketchUpAPI/model/classification_attribute.h>
+#include <SketchUpAPI/model/dynamic_component_info.h>
+#include <SketchUpAPI/model/dynamic_component_attribute.h>
+#include <SketchUpAPI/model/typed_value.h>
+#include <vector>
+#include <map>
+#include <string>
+#include "utilities.h"
+#include "Attributes.h"
+
+using namespace System;
+using namespace System::Collections;
+using namespace System::Collections::Generic;
+
+namespace SketchUpNET
+{
+	/// <summary>
+	/// Reads classifications and dynamic component attributes of component instances into columns,
+	/// one row per instance in traversal order
+	/// </summary>
+	class InstanceInfoReader
+	{
+	public:
+		/// <summary>
+		/// Dictionary name of dynamic component attribute columns
+		/// </summary>
+		static const char* DynamicDictionary() { return "dynamic_attributes"; }
+
+		std::map<std::string, AttributeProjection> Schemas;
+		AttributeProjection Dynamic;
+		bool ReadDynamic;
+		std::vector<AttributeColumnData> Columns;
+		std::vector<long long> Rows;
+
+		InstanceInfoReader()
+		{
+			ReadDynamic = false;
+			Dynamic.AllKeys = false;
+			value = SU_INVALID;
+			SUTypedValueCreate(&value);
+		}
+
+		~InstanceInfoReader()
+		{
+			SUTypedValueRelease(&value);
+		}
+
+		/// <summary>
+		/// Requests attribute paths of a classification schema, all attributes if none are given.
+		/// The applied schema type is always read into the column with an empty key.
+		/// </summary>
+		void ProjectSchema(const std::string& schema, const std::vector<std::string>& paths)
+		{
+			AttributeProjection& projection = Schemas[schema];
+			projection.AllKeys = paths.empty();
+			projection.Discovered[std::string()] = AddColumn(schema, std::string());
+			for (size_t i = 0; i < paths.size(); i++)
+				projection.Discovered[paths[i]] = AddColumn(schema, paths[i]);
+		}
+
+		/// <summary>
+		/// Requests dynamic component attributes by name, all attributes if none are given
+		/// </summary>
+		void ProjectDynamic(const std::vector<std::string>& names)
+		{
+			ReadDynamic = true;
+			Dynamic.AllKeys = names.empty();
+			for (size_t i = 0; i < names.size(); i++)
+				Dynamic.Discovered[names[i]] = AddColumn(DynamicDictionary(), names[i]);
+		}
+
+		/// <summary>
+		/// Adds a row for an instance and returns its index
+		/// </summary>
+		int Read(SUComponentInstanceRef instance)
+		{
+			int row = (int)Rows.size();
+			int64_t pid = 0;
+			SUEntityGetPersistentID(SUComponentInstanceToEntity(instance), &pid);
+			Rows.push_back(pid);
+
+			if (!Schemas.empty())
+				ReadClassifications(instance, row);
+			if (ReadDynamic)
+				ReadDynamicAttributes(instance, row);
+
+			return row;
+		}
+
+	private:
+		SUTypedValueRef value;
+
+		void ReadClassifications(SUComponentInstanceRef instance, int row)
+		{
+			SUClassificationInfoRef info = SU_INVALID;
+			if (SUComponentInstanceCreateClassificationInfo(instance, &info) != SU_ERROR_NONE) return;
+
+			size_t count = 0;
+			SUClassificationInfoGetNumSchemas(info, &count);
+			for (size_t i = 0; i < count; i++)
+			{
+				SUStringRef name = SU_INVALID;
+				SUStringCreate(&name);
+				SUClassificationInfoGetSchemaName(info, i, &name);
+				std::string schema = Take(name);
+
+				std::map<std::string, AttributeProjection>::iterator found = Schemas.find(schema);
+				if (found == Schemas.end()) continue;
+
+				SUStringRef type = SU_INVALID;
+				SUStringCreate(&type);
+				SUClassificationInfoGetSchemaType(info, i, &type);
+				AddText(found->second.Discovered[std::string()], row, Take(type));
+
+				SUClassificationAttributeRef attribute = SU_INVALID;
+				if (SUClassificationInfoGetSchemaAttribute(info, i, &attribute) == SU_ERROR_NONE)
+					ReadAttribute(attribute, schema, found->second, row);
+			}
+
+			SUClassificationInfoRelease(&info);
+		}
+
+		void ReadAttribute(SUClassificationAttributeRef attribute, const std::string& schema, AttributeProjection& projection, int row)
+		{
+			SUStringRef pathRef = SU_INVALID;
+			SUStringCreate(&pathRef);
+			SUClassificationAttributeGetPath(attribute, &pathRef);
+			std::string path = Take(pathRef);
+
+			int column = Column(schema, path, projection);
+			if (column >= 0 && !path.empty() && SUClassificationAttributeGetValue(attribute, &value) == SU_ERROR_NONE)
+			{
+				AttributeCell cell;
+				if (AttributeReader::ReadValue(value, cell))
+				{
+					cell.Row = row;
+					Columns[column].Cells.push_back(cell);
+				}
+			}
+
+			size_t count = 0;
+			SUClassificationAttributeGetNumChildren(attribute, &count);
+			for (size_t i = 0; i < count; i++)
+			{
+				SUClassificationAttributeRef child = SU_INVALID;
+				if (SUClassificationAttributeGetChild(attribute, i, &child) == SU_ERROR_NONE)
+					ReadAttribute(child, schema, projection, row);
+			}
+		}
+
+		void ReadDynamicAttributes(SUComponentInstanceRef instance, int row)
+		{
+			SUDynamicComponentInfoRef info = SU_INVALID;
+			if (SUComponentInstanceCreateDCInfo(instance, &info) != SU_ERROR_NONE) return;
+
+			size_t count = 0;
+			SUDynamicComponentInfoGetNumDCAttributes(info, &count);
+			if (count > 0)
+			{
+				std::vector<SUDynamicComponentAttributeRef> attributes(count);
+				SUDynamicComponentInfoGetDCAttributes(info, count, &attributes[0], &count);
+
+				for (size_t i = 0; i < count; i++)
+				{
+					SUStringRef name = SU_INVALID;
+					SUStringCreate(&name);
+					SUDynamicComponentAttributeGetName(attributes[i], &name);
+
+					int column = Column(DynamicDictionary(), Take(name), Dynamic);
+					if (column < 0) continue;
+
+					SUStringRef display = SU_INVALID;
+					SUStringCreate(&display);
+					SUDynamicComponentAttributeGetDisplayValue(attributes[i], &display);
+					AddText(column, row, Take(display));
+				}
+			}
+
+			SUDynamicComponentInfoRelease(&info);
+		}
+
+		/// <summary>
+		/// Column of a key, added on first sight if all keys are requested, -1 if not requested
+		/// </summary>
+		int Column(const std::string& dictionary, const std::string& key, AttributeProjection& projection)
+		{
+			std::map<std::string, int>::iterator found = projection.Discovered.find(key);
+			if (found != projection.Discovered.end()) return found->second;
+			if (!projection.AllKeys) return -1;
+
+			int column = AddColumn(dictionary, key);
+			projection.Discovered[key] = column;
+			return column;
+		}
+
+		int AddColumn(const std::string& dictionary, const std::string& key)
+		{
+			AttributeColumnData column;
+			column.Dictionary = dictionary;
+			column.Key = key;
+			Columns.push_back(column);
+			return (int)Columns.size() - 1;
+		}
+
+		void AddText(int column, int row, const std::string& text)
+		{
+			AttributeCell cell;
+			cell.Row = row;
+			cell.Storage = (int)AttributeType::String;
+			cell.Integer = 0;
+			cell.Number[0] = cell.Number[1] = cell.Number[2] = 0;
+			cell.Text = text;
+			Columns[column].Cells.push_back(cell);
+		}
+
+		/// <summary>
+		/// Converts and releases a string
+		/// </summary>
+		static std::string Take(SUStringRef& text)
+		{
+			std::string result = Utilities::GetNativeString(text);
+			SUStringRelease(&text);
+			return result;
+		}
+	};
+
+	/// <summary>
+	/// Collects instance rows while a model is loaded, see LoadOptions.Classifications and LoadOptions.DynamicAttributes
+	/// </summary>
+	private ref class InstanceInfoCollector
+	{
+	public:
+		InstanceInfoCollector(Dictionary<String^, array<String^>^>^ schemas, array<String^>^ dynamicAttributes)
+		{
+			reader = new InstanceInfoReader();
+
+			if (schemas != nullptr)
+			{
+				for each (KeyValuePair<String^, array<String^>^> entry in schemas)
+				{
+					std::vector<std::string> paths;
+					if (entry.Value != nullptr)
+					{
+						for each (String^ path in entry.Value)
+							paths.push_back(AttributeTable::ToNative(path));
+					}
+					reader->ProjectSchema(AttributeTable::ToNative(entry.Key), paths);
+				}
+			}
+
+			if (dynamicAttributes != nullptr)
+			{
+				std::vector<std::string> names;
+				for each (String^ name in dynamicAttributes)
+					names.push_back(AttributeTable::ToNative(name));
+				reader->ProjectDynamic(names);
+			}
+		}
+
+		~InstanceInfoCollector()
+		{
+			this->!InstanceInfoCollector();
+		}
+
+		!InstanceInfoCollector()
+		{
+			delete reader;
+			reader = NULL;
+		}
+
+		int Read(SUComponentInstanceRef instance)
+		{
+			return reader->Read(instance);
+		}
+
+		AttributeTable^ ToTable()
+		{
+			return AttributeTable::FromData(reader->Rows, reader->Columns);
+		}
+
+	private:
+		InstanceInfoReader* reader;
+	};
+
+
+}
@@ -0,0 +1,74 @@
+/*
+
+SketchUpNET - a C++ Wrapper for the Trimble(R) SketchUp(R) C API
+Copyright(C) 2015, Autor: Maximilian Thumfart
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+#pragma once
+
+#include <SketchUpAPI/model/drawing_element.h>
+#include "LoadOptions.h"
+#include "Visibility.h"
+#include "InstanceInfo.h"
+
+using namespace System;
+using namespace System::Collections;
+using namespace System::Collections::Generic;
+
+namespace SketchUpNET
+{
+	/// <summary>
+	/// State of a single traversal, created per load so options can be shared between loads
+	/// </summary>
+	private ref class LoadContext
+	{
+	public:
+		LoadContext(LoadOptions^ options)
+		{
+			this->Options = options;
+		};
+
+		/// <summary>
+		/// Options of the caller, never written while loading
+		/// </summary>
+		LoadOptions^ Options;
+
+		/// <summary>
+		/// Filter of this traversal, set if VisibleOnly is enabled or a scene is loaded
+		/// </summary>
+		VisibilityFilter^ Visibility;
+
+		/// <summary>
+		/// Instance rows of this traversal, set if Classifications or DynamicAttributes are requested
+		/// </summary>
+		InstanceInfoCollector^ InstanceInfo;
+
+		/// <summary>
+		/// Group definitions referenced so far and the ones still to read, set while loading a model.
+		/// Groups read without them extract their contents on their own.
+		/// </summary>
+		HashSet<IntPtr>^ GroupDefinitions;
+		List<IntPtr>^ PendingGroupDefinitions;
+
+		bool IsVisible(SUDrawingElementRef element)
+		{
+			return Visibility == nullptr || Visibility->IsVisible(element);
+		}
+	};
+
+
+}
@@ -0,0 +1,147 @@
+/*
+
+SketchUpNET - a C++ Wrapper for the Trimble(R) SketchUp(R) C API
+Copyright(C) 2015, Autor: Maximilian Thumfart
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+#pragma once
+
+using namespace System;
+using namespace System::Collections;
+using namespace System::Collections::Generic;
+
+namespace SketchUpNET
+{
+	/// <summary>
+	/// Annotation entity kinds to read into AnnotationTables
+	/// </summary>
+	[Flags]
+	public enum class AnnotationKinds
+	{
+		None = 0,
+		GuidePoints = 1,
+		GuideLines = 2,
+		Polylines = 4,
+		Texts = 8,
+		Dimensions = 16,
+		All = GuidePoints | GuideLines | Polylines | Texts | Dimensions
+	};
+
+	/// <summary>
+	/// Edge classification bits, see Edge.Flags
+	/// </summary>
+	[Flags]
+	public enum class EdgeFlags : Byte
+	{
+		None = 0,
+		Soft = 1,
+		Smooth = 2,
+		Hidden = 4
+	};
+
+	/// <summary>
+	/// Options controlling which data is read when loading a model
+	/// </summary>
+	public ref class LoadOptions
+	{
+	public:
+		/// <summary>
+		/// Load meshed geometries of surfaces and merged meshes of component definitions
+		/// </summary>
+		bool IncludeMeshes;
+
+		/// <summary>
+		/// Load surface loops as compact point rings (Surface.Rings) instead of Edge objects.
+		/// OuterEdges and InnerEdges stay empty in this mode.
+		/// </summary>
+		bool LoopsAsPoints;
+
+		/// <summary>
+		/// Check groups and component definitions for closed shells and compute their volumes (Solid)
+		/// </summary>
+		bool AnalyzeSolids;
+
+		/// <summary>
+		/// Load arcs and circles analytically into an ArcTable (Arcs) instead of edge lists.
+		/// Curves and Edges only hold the remaining non arc curves and edges in this mode.
+		/// </summary>
+		bool ArcsAsTable;
+
+		/// <summary>
+		/// Skip edges with any of these flags before they are read, e.g. Soft | Smooth | Hidden for hard edges only.
+		/// Applies to Edges of the model, groups and components, face loops always keep all their edges.
+		/// </summary>
+		EdgeFlags SkipEdges;
+
+		/// <summary>
+		/// Attribute dictionary names and the keys to read from them into SketchUp.Attributes,
+		/// a null or empty key list reads all keys of a dictionary.
+		/// Attributes are read for the whole model, VisibleOnly and Scene don't apply to them.
+		/// </summary>
+		Dictionary<String^, array<String^>^>^ Attributes;
+
+		/// <summary>
+		/// Index all loaded surfaces, edges, instances, groups and components by persistent id (SketchUp.PersistentIndex)
+		/// </summary>
+		bool IndexPersistentIds;
+
+		/// <summary>
+		/// Skip hidden entities and entities on hidden layers or layer folders.
+		/// Hidden groups and instances are skipped including their contents,
+		/// component definitions only used by hidden instances aren't loaded.
+		/// </summary>
+		bool VisibleOnly;
+
+		/// <summary>
+		/// Name of a scene to load exactly what it shows, using its hidden layers, layer folders and root level entities.
+		/// SketchUp.Camera holds the scene camera afterwards.
+		/// </summary>
+		System::String^ Scene;
+
+		/// <summary>
+		/// Annotation kinds to read into Annotations of the model, groups and components while loading.
+		/// None by default, which skips annotations entirely.
+		/// </summary>
+		AnnotationKinds Annotations;
+
+		/// <summary>
+		/// Load openings cut by glued components into Surface.Openings and Component.Openings
+		/// </summary>
+		bool Openings;
+
+		/// <summary>
+		/// Classification schema names, e.g. "IFC 2x3", and the attribute paths to read from them into SketchUp.InstanceInfo,
+		/// a null or empty path list reads all attributes. The applied schema type is read into the column with an empty key.
+		/// </summary>
+		Dictionary<String^, array<String^>^>^ Classifications;
+
+		/// <summary>
+		/// Names of dynamic component attributes to read into SketchUp.InstanceInfo, an empty array reads all attributes
+		/// </summary>
+		array<String^>^ DynamicAttributes;
+
+		LoadOptions(bool includeMeshes)
+		{
+			this->IncludeMeshes = includeMeshes;
+		};
+
+		LoadOptions(){};
+	};
+
+
+}
@@ -121,8 +121,9 @@ namespace SketchUpNET
 			}
 
 
+			// One normal per vertex
 			size_t nCount = 0;
-			SUMeshHelperGetNumTriangles(helper, &nCount);
+			SUMeshHelperGetNumVertices(helper, &nCount);
 			if (nCount > 0)
 			{
 				std::vector<SUVector3D> norms(nCount);
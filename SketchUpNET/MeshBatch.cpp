@@ -0,0 +1,998 @@
+/*
+
+SketchUpNET - a C++ Wrapper for the Trimble(R) SketchUp(R) C API
+Copyright(C) 2015, Autor: Maximilian Thumfart
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <SketchUpAPI/slapi.h>
+#include <SketchUpAPI/geometry.h>
+#include <SketchUpAPI/initialize.h>
+#include <SketchUpAPI/unicodestring.h>
+#include <SketchUpAPI/model/model.h>
+#include <SketchUpAPI/model/entities.h>
+#include <SketchUpAPI/model/face.h>
+#include <SketchUpAPI/model/edge.h>
+#include <SketchUpAPI/model/vertex.h>
+#include <SketchUpAPI/model/layer.h>
+#include <SketchUpAPI/model/material.h>
+#include <SketchUpAPI/model/group.h>
+#include <SketchUpAPI/model/component_instance.h>
+#include <SketchUpAPI/model/component_definition.h>
+#include <SketchUpAPI/model/drawing_element.h>
+#include <SketchUpAPI/model/entity.h>
+#include <SketchUpAPI/model/mesh_helper.h>
+#include <msclr/marshal.h>
+#include <vcclr.h>
+#include <vector>
+#include <map>
+#include <string>
+#include "utilities.h"
+#include "Transform.h"
+#include "Simplifier.h"
+#include "NormalSmoother.h"
+#include "MeshOptimizer.h"
+#include "MeshletTable.h"
+#include "Material.h"
+#include "LoadContext.h"
+
+using namespace System;
+using namespace System::Collections;
+using namespace System::Collections::Generic;
+
+namespace SketchUpNET
+{
+	/// <summary>
+	/// Criteria used to merge faces into mesh batches
+	/// </summary>
+	public enum class MeshBatchGrouping
+	{
+		Layer,
+		Material,
+		All,
+		LayerAndMaterial
+	};
+
+	/// <summary>
+	/// Native triangle buffers faces are merged into
+	/// </summary>
+	struct MeshBuffer
+	{
+		std::string Layer;
+		std::string Material;
+		std::vector<double> Positions;
+		std::vector<double> Normals;
+		std::vector<double> TexCoords;
+		std::vector<int> Indices;
+
+		/// <summary>
+		/// Material of each triangle, numbered by the collector
+		/// </summary>
+		std::vector<int> MaterialIds;
+
+		/// <summary>
+		/// Source face of each triangle as index into FacePersistentIds
+		/// </summary>
+		std::vector<int> FaceIds;
+		std::vector<int64_t> FacePersistentIds;
+
+		/// <summary>
+		/// Soft and smooth edges of the appended faces as start and end point in meters, six values per edge
+		/// </summary>
+		std::vector<double> SoftEdges;
+
+		/// <summary>
+		/// Triangulates a face and appends it transformed by a SUTransformation (in inches)
+		/// </summary>
+		void AppendFace(SUFaceRef face, const double* transform, const double* normalMatrix, bool flip, int materialId)
+		{
+			SUMeshHelperRef helper = SU_INVALID;
+			if (SUMeshHelperCreate(&helper, face) != SU_ERROR_NONE) return;
+
+			size_t vCount = 0;
+			size_t tCount = 0;
+			SUMeshHelperGetNumVertices(helper, &vCount);
+			SUMeshHelperGetNumTriangles(helper, &tCount);
+
+			if (vCount > 0 && tCount > 0)
+			{
+				std::vector<SUPoint3D> vs(vCount);
+				std::vector<SUVector3D> ns(vCount);
+				std::vector<SUPoint3D> stq(vCount);
+				std::vector<size_t> fs(3 * tCount);
+				size_t ret = 0;
+
+				SUMeshHelperGetVertices(helper, vCount, &vs[0], &ret);
+				SUMeshHelperGetNormals(helper, vCount, &ns[0], &ret);
+				SUMeshHelperGetFrontSTQCoords(helper, vCount, &stq[0], &ret);
+				SUMeshHelperGetVertexIndices(helper, 3 * tCount, &fs[0], &ret);
+
+				int offset = (int)(Positions.size() / 3);
+				Positions.reserve(Positions.size() + 3 * vCount);
+				Normals.reserve(Normals.size() + 3 * vCount);
+				TexCoords.reserve(TexCoords.size() + 2 * vCount);
+				Indices.reserve(Indices.size() + 3 * tCount);
+
+				for (size_t j = 0; j < vCount; j++)
+				{
+					double p[3] = { vs[j].x, vs[j].y, vs[j].z };
+					double n[3] = { ns[j].x, ns[j].y, ns[j].z };
+					TransformMath::TransformPoint(transform, p, p);
+					TransformMath::TransformNormal(normalMatrix, n, n);
+
+					Positions.push_back(p[0] * 0.0254);
+					Positions.push_back(p[1] * 0.0254);
+					Positions.push_back(p[2] * 0.0254);
+					Normals.push_back(n[0]);
+					Normals.push_back(n[1]);
+					Normals.push_back(n[2]);
+
+					double q = (stq[j].z != 0.0) ? stq[j].z : 1.0;
+					TexCoords.push_back(stq[j].x / q);
+					TexCoords.push_back(stq[j].y / q);
+				}
+
+				for (size_t j = 0; j < 3 * tCount; j = j + 3)
+				{
+					Indices.push_back(offset + (int)fs[j]);
+					Indices.push_back(offset + (int)fs[flip ? j + 2 : j + 1]);
+					Indices.push_back(offset + (int)fs[flip ? j + 1 : j + 2]);
+				}
+				MaterialIds.resize(MaterialIds.size() + tCount, materialId);
+
+				int64_t pid = 0;
+				SUEntityGetPersistentID(SUFaceToEntity(face), &pid);
+				FaceIds.resize(FaceIds.size() + tCount, (int)FacePersistentIds.size());
+				FacePersistentIds.push_back(pid);
+
+				AppendSoftEdges(face, transform);
+			}
+
+			SUMeshHelperRelease(&helper);
+		}
+
+		void AppendSoftEdges(SUFaceRef face, const double* transform)
+		{
+			size_t eCount = 0;
+			SUFaceGetNumEdges(face, &eCount);
+			if (eCount == 0) return;
+
+			std::vector<SUEdgeRef> edges(eCount);
+			SUFaceGetEdges(face, eCount, &edges[0], &eCount);
+			for (size_t j = 0; j < eCount; j++)
+			{
+				bool soft = false;
+				bool smooth = false;
+				SUEdgeGetSoft(edges[j], &soft);
+				SUEdgeGetSmooth(edges[j], &smooth);
+				if (!soft && !smooth) continue;
+
+				SUVertexRef ends[2] = { SU_INVALID, SU_INVALID };
+				SUEdgeGetStartVertex(edges[j], &ends[0]);
+				SUEdgeGetEndVertex(edges[j], &ends[1]);
+				for (int k = 0; k < 2; k++)
+				{
+					SUPoint3D position = SU_INVALID;
+					SUVertexGetPosition(ends[k], &position);
+					double p[3] = { position.x, position.y, position.z };
+					TransformMath::TransformPoint(transform, p, p);
+
+					SoftEdges.push_back(p[0] * 0.0254);
+					SoftEdges.push_back(p[1] * 0.0254);
+					SoftEdges.push_back(p[2] * 0.0254);
+				}
+			}
+		}
+	};
+
+	/// <summary>
+	/// Walks entities recursively, including groups and component instances,
+	/// and merges all faces in world space into one buffer per layer or material.
+	/// With a load context hidden faces and hidden groups and instances including their contents are skipped.
+	/// </summary>
+	class MeshBatchCollector
+	{
+	public:
+		enum GroupingMode { ByLayer = 0, ByMaterial = 1, All = 2, ByLayerAndMaterial = 3 };
+
+		std::map<std::string, MeshBuffer> Buffers;
+
+		MeshBatchCollector(GroupingMode mode, SULayerRef defaultLayer, LoadContext^ context)
+		{
+			this->mode = mode;
+			this->defaultLayer = defaultLayer;
+			this->context = context;
+		}
+
+		void Collect(SUEntitiesRef entities, const double* transform, SUMaterialRef material, SULayerRef layer)
+		{
+			double normalMatrix[9];
+			TransformMath::NormalMatrix(transform, normalMatrix);
+			bool flip = TransformMath::Determinant(transform) < 0;
+
+			size_t faceCount = 0;
+			SUEntitiesGetNumFaces(entities, &faceCount);
+			if (faceCount > 0)
+			{
+				std::vector<SUFaceRef> faces(faceCount);
+				SUEntitiesGetFaces(entities, faceCount, &faces[0], &faceCount);
+
+				for (size_t i = 0; i < faceCount; i++)
+				{
+					if (!IsVisible(SUFaceToDrawingElement(faces[i]))) continue;
+
+					SUMaterialRef faceMaterial = SU_INVALID;
+					SUFaceGetFrontMaterial(faces[i], &faceMaterial);
+					SULayerRef faceLayer = SU_INVALID;
+					SUDrawingElementGetLayer(SUFaceToDrawingElement(faces[i]), &faceLayer);
+
+					SUMaterialRef resolved = ResolveMaterial(faceMaterial, material);
+					MeshBuffer& buffer = GetBuffer(resolved, ResolveLayer(faceLayer, layer));
+					buffer.AppendFace(faces[i], transform, normalMatrix, flip, GetMaterialId(resolved));
+				}
+			}
+
+			size_t groupCount = 0;
+			SUEntitiesGetNumGroups(entities, &groupCount);
+			if (groupCount > 0)
+			{
+				std::vector<SUGroupRef> groups(groupCount);
+				SUEntitiesGetGroups(entities, groupCount, &groups[0], &groupCount);
+
+				for (size_t i = 0; i < groupCount; i++)
+				{
+					SUTransformation local = SU_INVALID;
+					SUGroupGetTransform(groups[i], &local);
+					SUEntitiesRef groupEntities = SU_INVALID;
+					SUGroupGetEntities(groups[i], &groupEntities);
+
+					CollectChild(SUGroupToDrawingElement(groups[i]), groupEntities, transform, local.values, material, layer);
+				}
+			}
+
+			size_t instanceCount = 0;
+			SUEntitiesGetNumInstances(entities, &instanceCount);
+			if (instanceCount > 0)
+			{
+				std::vector<SUComponentInstanceRef> instances(instanceCount);
+				SUEntitiesGetInstances(entities, instanceCount, &instances[0], &instanceCount);
+
+				for (size_t i = 0; i < instanceCount; i++)
+				{
+					SUTransformation local = SU_INVALID;
+					SUComponentInstanceGetTransform(instances[i], &local);
+					SUComponentDefinitionRef definition = SU_INVALID;
+					SUComponentInstanceGetDefinition(instances[i], &definition);
+					SUEntitiesRef definitionEntities = SU_INVALID;
+					SUComponentDefinitionGetEntities(definition, &definitionEntities);
+
+					CollectChild(SUComponentInstanceToDrawingElement(instances[i]), definitionEntities, transform, local.values, material, layer);
+				}
+			}
+		}
+
+	private:
+		GroupingMode mode;
+		SULayerRef defaultLayer;
+		gcroot<LoadContext^> context;
+		std::map<void*, std::string> names;
+		std::map<void*, int> materialIds;
+
+		int GetMaterialId(SUMaterialRef material)
+		{
+			std::map<void*, int>::iterator it = materialIds.find(material.ptr);
+			if (it != materialIds.end()) return it->second;
+
+			int id = (int)materialIds.size();
+			materialIds[material.ptr] = id;
+			return id;
+		}
+
+		bool IsVisible(SUDrawingElementRef element)
+		{
+			LoadContext^ loading = context;
+			return loading == nullptr || loading->IsVisible(element);
+		}
+
+		void CollectChild(SUDrawingElementRef element, SUEntitiesRef entities, const double* transform, const double* local, SUMaterialRef material, SULayerRef layer)
+		{
+			if (!IsVisible(element)) return;
+
+			SUMaterialRef elementMaterial = SU_INVALID;
+			SUDrawingElementGetMaterial(element, &elementMaterial);
+			SULayerRef elementLayer = SU_INVALID;
+			SUDrawingElementGetLayer(element, &elementLayer);
+
+			double world[16];
+			TransformMath::Multiply(transform, local, world);
+
+			Collect(entities, world, ResolveMaterial(elementMaterial, material), ResolveLayer(elementLayer, layer));
+		}
+
+		// Faces without material are painted with the material of their group or instance
+		SUMaterialRef ResolveMaterial(SUMaterialRef own, SUMaterialRef inherited)
+		{
+			return SUIsInvalid(own) ? inherited : own;
+		}
+
+		// Entities on the default layer are displayed on the layer of their group or instance
+		SULayerRef ResolveLayer(SULayerRef own, SULayerRef inherited)
+		{
+			if (SUIsInvalid(own) || (own.ptr == defaultLayer.ptr && !SUIsInvalid(inherited)))
+				return inherited;
+			return own;
+		}
+
+		const std::string& GetName(void* ref, bool isMaterial)
+		{
+			std::map<void*, std::string>::iterator it = names.find(ref);
+			if (it != names.end()) return it->second;
+
+			std::string name;
+			if (ref != NULL)
+			{
+				SUStringRef nameRef = SU_INVALID;
+				SUStringCreate(&nameRef);
+				if (isMaterial)
+				{
+					SUMaterialRef material = SU_INVALID;
+					material.ptr = ref;
+					SUMaterialGetName(material, &nameRef);
+				}
+				else
+				{
+					SULayerRef layer = SU_INVALID;
+					layer.ptr = ref;
+					SULayerGetName(layer, &nameRef);
+				}
+				name = Utilities::GetNativeString(nameRef);
+				SUStringRelease(&nameRef);
+			}
+
+			return names[ref] = name;
+		}
+
+		MeshBuffer& GetBuffer(SUMaterialRef material, SULayerRef layer)
+		{
+			const std::string& materialName = GetName(material.ptr, true);
+			const std::string& layerName = GetName(layer.ptr, false);
+
+			std::string key;
+			if (mode == ByMaterial) key = materialName;
+			else if (mode == ByLayer) key = layerName;
+			else if (mode == ByLayerAndMaterial) key = layerName + '\0' + materialName;
+
+			std::map<std::string, MeshBuffer>::iterator it = Buffers.find(key);
+			if (it != Buffers.end()) return it->second;
+
+			MeshBuffer& buffer = Buffers[key];
+			buffer.Layer = layerName;
+			buffer.Material = materialName;
+			return buffer;
+		}
+	};
+
+	/// <summary>
+	/// Vertex cache efficiency of a batch before and after MeshBatch.Optimize
+	/// </summary>
+	public ref class VertexCacheReport
+	{
+	public:
+		/// <summary>
+		/// Average cache misses per triangle, between about 0.5 and 3, lower is better
+		/// </summary>
+		double AcmrBefore;
+		double AcmrAfter;
+
+		/// <summary>
+		/// Simulated FIFO cache size in vertices
+		/// </summary>
+		int CacheSize;
+
+		VertexCacheReport(){};
+	};
+
+	/// <summary>
+	/// Merged triangles of many faces stored in flat buffers,
+	/// ready to be turned into a single mesh without per vertex objects
+	/// </summary>
+	public ref class MeshBatch
+	{
+	public:
+		/// <summary>
+		/// Name of the layer or material this batch has been merged by
+		/// </summary>
+		System::String^ Name;
+
+		/// <summary>
+		/// Layer of the merged faces, or of the first merged face if merged by material
+		/// </summary>
+		System::String^ Layer;
+
+		/// <summary>
+		/// Material of the merged faces, or of the first merged face if merged by layer
+		/// </summary>
+		SketchUpNET::Material^ Material;
+
+		/// <summary>
+		/// Vertex positions in meters as x,y,z triplets, in world space for model batches
+		/// </summary>
+		array<double>^ Positions;
+
+		/// <summary>
+		/// Vertex normals as x,y,z triplets, in world space for model batches
+		/// </summary>
+		array<double>^ Normals;
+
+		/// <summary>
+		/// Front side texture coordinates as u,v pairs
+		/// </summary>
+		array<double>^ TexCoords;
+
+		/// <summary>
+		/// Triangle vertex indices, three per triangle
+		/// </summary>
+		array<int>^ Indices;
+
+		/// <summary>
+		/// Index of the source face of each triangle, into FacePersistentIds for model and component batches,
+		/// into the triangulated list if triangulated from surfaces
+		/// </summary>
+		array<int>^ FaceIds;
+
+		/// <summary>
+		/// Persistent id of each source face, see FaceIds. Faces of components appear once per placement.
+		/// </summary>
+		array<Int64>^ FacePersistentIds;
+
+		/// <summary>
+		/// Simplified levels of detail, each coarser than the one before, see Simplify
+		/// </summary>
+		List<MeshBatch^>^ Lods;
+
+		/// <summary>
+		/// Meshlets for cluster based culling, see BuildMeshlets. Optimize reorders the triangles
+		/// they refer to and resets them to null.
+		/// </summary>
+		MeshletTable^ Meshlets;
+
+		property int VertexCount
+		{
+			int get() { return (Positions == nullptr) ? 0 : Positions->Length / 3; }
+		}
+
+		property int TriangleCount
+		{
+			int get() { return (Indices == nullptr) ? 0 : Indices->Length / 3; }
+		}
+
+		MeshBatch(System::String^ name, System::String^ layer, SketchUpNET::Material^ material, array<double>^ positions, array<double>^ normals, array<double>^ texCoords, array<int>^ indices)
+		{
+			this->Name = name;
+			this->Layer = layer;
+			this->Material = material;
+			this->Positions = positions;
+			this->Normals = normals;
+			this->TexCoords = texCoords;
+			this->Indices = indices;
+		};
+
+		MeshBatch() {};
+
+		/// <summary>
+		/// Returns a copy of this batch transformed by a component instance or group transformation
+		/// </summary>
+		/// <param name="transformation">Transformation to apply</param>
+		MeshBatch^ Transformed(Transform^ transformation)
+		{
+			List<MeshBatch^>^ batches = gcnew List<MeshBatch^>();
+			List<Transform^>^ transformations = gcnew List<Transform^>();
+			batches->Add(this);
+			transformations->Add(transformation);
+
+			return MeshBatch::Merge(batches, transformations);
+		}
+
+		/// <summary>
+		/// Merges batches into a single batch, each transformed by the transformation at the same index.
+		/// Name, layer and material are taken from the first batch.
+		/// </summary>
+		/// <param name="batches">Batches to merge</param>
+		/// <param name="transformations">Transformation per batch, null entries are not transformed</param>
+		static MeshBatch^ Merge(List<MeshBatch^>^ batches, List<Transform^>^ transformations)
+		{
+			MeshBuffer buffer;
+
+			size_t vCount = 0;
+			size_t iCount = 0;
+			for each (MeshBatch^ batch in batches)
+			{
+				vCount += batch->VertexCount;
+				iCount += batch->TriangleCount * 3;
+			}
+			buffer.Positions.reserve(3 * vCount);
+			buffer.Normals.reserve(3 * vCount);
+			buffer.TexCoords.reserve(2 * vCount);
+			buffer.Indices.reserve(iCount);
+
+			// Face ids are kept if all batches have them and shifted past the faces of the batches before
+			bool hasFaces = true;
+			bool hasPersistentIds = true;
+			for each (MeshBatch^ batch in batches)
+			{
+				hasFaces = hasFaces && batch->FaceIds != nullptr && batch->FaceIds->Length == batch->TriangleCount;
+				hasPersistentIds = hasPersistentIds && batch->FacePersistentIds != nullptr;
+			}
+			hasPersistentIds = hasPersistentIds && hasFaces;
+			std::vector<int64_t> persistentIds;
+			int firstFace = 0;
+
+			// Batches count as different materials, ids within a batch are shifted past the ones before
+			int firstId = 0;
+			for (int i = 0; i < batches->Count; i++)
+			{
+				double transform[16];
+				TransformMath::Identity(transform);
+				if (transformations != nullptr && i < transformations->Count && transformations[i] != nullptr)
+					transformations[i]->CopyTo(transform);
+
+				AppendTransformed(buffer, batches[i], transform);
+
+				int lastId = firstId;
+				for (int t = 0; t < batches[i]->TriangleCount; t++)
+				{
+					int id = firstId + ((batches[i]->MaterialIds != nullptr) ? batches[i]->MaterialIds[t] : 0);
+					buffer.MaterialIds.push_back(id);
+					lastId = (std::max)(lastId, id);
+				}
+				firstId = lastId + 1;
+
+				if (hasFaces)
+				{
+					int lastFace = firstFace - 1;
+					for (int t = 0; t < batches[i]->TriangleCount; t++)
+					{
+						buffer.FaceIds.push_back(firstFace + batches[i]->FaceIds[t]);
+						lastFace = (std::max)(lastFace, firstFace + batches[i]->FaceIds[t]);
+					}
+
+					if (hasPersistentIds)
+					{
+						for each (Int64 pid in batches[i]->FacePersistentIds)
+							persistentIds.push_back(pid);
+						firstFace = (int)persistentIds.size();
+					}
+					else
+						firstFace = lastFace + 1;
+				}
+			}
+
+			MeshBatch^ first = (batches->Count > 0) ? batches[0] : gcnew MeshBatch();
+			MeshBatch^ v = gcnew MeshBatch(first->Name, first->Layer, first->Material,
+				Utilities::ToArray(buffer.Positions), Utilities::ToArray(buffer.Normals), Utilities::ToArray(buffer.TexCoords), Utilities::ToArray(buffer.Indices));
+			v->MaterialIds = MixedMaterialIds(buffer.MaterialIds);
+			if (hasFaces)
+				v->FaceIds = Utilities::ToArray(buffer.FaceIds);
+			if (hasPersistentIds)
+				v->FacePersistentIds = Utilities::ToArray(persistentIds);
+			v->SoftEdges = Utilities::ToArray(buffer.SoftEdges);
+
+			return v;
+		}
+
+		/// <summary>
+		/// Returns a simplified copy of this batch, see Simplify(List, double, double)
+		/// </summary>
+		/// <param name="targetTriangles">Stop once no more than this many triangles are left</param>
+		/// <param name="maxError">Largest allowed deviation in meters, use Double.MaxValue to simplify by count only</param>
+		MeshBatch^ Simplify(int targetTriangles, double maxError)
+		{
+			MeshSimplifier simplifier;
+			SetupSimplifier(simplifier, this, targetTriangles, maxError);
+			simplifier.Run();
+			return FromSimplifier(simplifier, this);
+		}
+
+		/// <summary>
+		/// Simplifies batches in parallel by quadric error edge collapses. Open borders, which include
+		/// material boundaries of batches merged by material, are kept, and so are the boundaries
+		/// between materials of batches merged by layer and texture seams of textured materials.
+		/// Kept vertices keep their normals and texture coordinates.
+		/// </summary>
+		/// <param name="batches">Batches to simplify</param>
+		/// <param name="ratio">Target triangle count as fraction of the original count</param>
+		/// <param name="maxError">Largest allowed deviation in meters, use Double.MaxValue to simplify by ratio only</param>
+		static List<MeshBatch^>^ Simplify(List<MeshBatch^>^ batches, double ratio, double maxError)
+		{
+			List<MeshBatch^>^ result = gcnew List<MeshBatch^>();
+			if (batches->Count == 0) return result;
+
+			std::vector<MeshSimplifier> simplifiers(batches->Count);
+			for (int i = 0; i < batches->Count; i++)
+				SetupSimplifier(simplifiers[i], batches[i], (int)ceil(batches[i]->TriangleCount * ratio), maxError);
+
+			SimplifyKernel kernel;
+			kernel.Simplifiers = &simplifiers[0];
+			Utilities::ParallelFor(batches->Count, kernel);
+
+			for (int i = 0; i < batches->Count; i++)
+				result->Add(FromSimplifier(simplifiers[i], batches[i]));
+
+			return result;
+		}
+
+		/// <summary>
+		/// Fills Lods of every batch with one simplified batch per ratio
+		/// </summary>
+		/// <param name="batches">Batches to simplify</param>
+		/// <param name="ratios">Target triangle count of each level as fraction of the original count, descending</param>
+		/// <param name="maxError">Largest allowed deviation in meters</param>
+		static void AddLods(List<MeshBatch^>^ batches, array<double>^ ratios, double maxError)
+		{
+			for each (MeshBatch^ batch in batches)
+				batch->Lods = gcnew List<MeshBatch^>();
+
+			for each (double ratio in ratios)
+			{
+				List<MeshBatch^>^ lods = MeshBatch::Simplify(batches, ratio, maxError);
+				for (int i = 0; i < batches->Count; i++)
+					batches[i]->Lods->Add(lods[i]);
+			}
+		}
+
+		/// <summary>
+		/// Replaces Normals by smooth normals, see SmoothNormals(List, double)
+		/// </summary>
+		/// <param name="creaseAngle">Faces meeting at a larger angle in degrees keep separate normals</param>
+		void SmoothNormals(double creaseAngle)
+		{
+			List<MeshBatch^>^ batches = gcnew List<MeshBatch^>();
+			batches->Add(this);
+			MeshBatch::SmoothNormals(batches, creaseAngle);
+		}
+
+		/// <summary>
+		/// Replaces Normals of every batch by smooth normals. Vertices at the same position are welded and
+		/// average the area weighted normals of all adjacent faces within the crease angle. Faces joined by
+		/// soft or smooth edges always blend, other edges sharper than the crease angle stay hard.
+		/// Vertices are processed in parallel.
+		/// </summary>
+		/// <param name="batches">Batches to update</param>
+		/// <param name="creaseAngle">Faces meeting at a larger angle in degrees keep separate normals</param>
+		static void SmoothNormals(List<MeshBatch^>^ batches, double creaseAngle)
+		{
+			double cosCrease = cos(creaseAngle * 3.14159265358979323846 / 180.0);
+
+			for each (MeshBatch^ batch in batches)
+			{
+				if (batch->VertexCount == 0) continue;
+
+				NormalSmoother smoother;
+				Utilities::FromArray(batch->Positions, smoother.Positions);
+				Utilities::FromArray(batch->Indices, smoother.Indices);
+				Utilities::FromArray(batch->Normals, smoother.Normals);
+				Utilities::FromArray(batch->SoftEdges, smoother.SoftEdges);
+				if (batch->FaceIds != nullptr && batch->FaceIds->Length == batch->TriangleCount)
+					Utilities::FromArray(batch->FaceIds, smoother.FaceIds);
+				smoother.CosCrease = cosCrease;
+				smoother.Prepare();
+
+				SmoothNormalsKernel kernel;
+				kernel.Smoother = &smoother;
+				Utilities::ParallelFor(batch->VertexCount, kernel);
+
+				batch->Normals = Utilities::ToArray(smoother.Normals);
+			}
+		}
+
+		/// <summary>
+		/// Average cache misses per triangle of Indices for a FIFO vertex cache
+		/// </summary>
+		/// <param name="cacheSize">Cache size in vertices</param>
+		double Acmr(int cacheSize)
+		{
+			std::vector<int> indices;
+			Utilities::FromArray(Indices, indices);
+			return MeshOptimizer::Acmr(indices, cacheSize);
+		}
+
+		/// <summary>
+		/// Reorders this batch for rendering, see Optimize(List, int)
+		/// </summary>
+		/// <param name="cacheSize">Vertex cache size of the target GPU, e.g. 16 or 32</param>
+		VertexCacheReport^ Optimize(int cacheSize)
+		{
+			List<MeshBatch^>^ batches = gcnew List<MeshBatch^>();
+			batches->Add(this);
+			return MeshBatch::Optimize(batches, cacheSize)[0];
+		}
+
+		/// <summary>
+		/// Reorders triangles and vertices of every batch in place for the GPU, in parallel per batch.
+		/// Triangles are ordered by Tipsify for the vertex cache, clusters of triangles are sorted
+		/// outside in against overdraw and vertices are renumbered in order of first use.
+		/// Geometry stays the same, FaceIds follow their triangles, Lods are not changed.
+		/// Meshlets are reset to null, call BuildMeshlets again afterwards.
+		/// </summary>
+		/// <param name="batches">Batches to reorder</param>
+		/// <param name="cacheSize">Vertex cache size of the target GPU, e.g. 16 or 32</param>
+		/// <returns>ACMR before and after per batch</returns>
+		static List<VertexCacheReport^>^ Optimize(List<MeshBatch^>^ batches, int cacheSize)
+		{
+			List<VertexCacheReport^>^ result = gcnew List<VertexCacheReport^>();
+			if (batches->Count == 0) return result;
+
+			std::vector<MeshOptimizer> optimizers(batches->Count);
+			for (int i = 0; i < batches->Count; i++)
+			{
+				Utilities::FromArray(batches[i]->Positions, optimizers[i].Positions);
+				Utilities::FromArray(batches[i]->Normals, optimizers[i].Normals);
+				Utilities::FromArray(batches[i]->TexCoords, optimizers[i].TexCoords);
+				Utilities::FromArray(batches[i]->Indices, optimizers[i].Indices);
+				Utilities::FromArray(batches[i]->FaceIds, optimizers[i].FaceIds);
+				Utilities::FromArray(batches[i]->MaterialIds, optimizers[i].MaterialIds);
+				optimizers[i].CacheSize = cacheSize;
+			}
+
+			OptimizeKernel kernel;
+			kernel.Optimizers = &optimizers[0];
+			Utilities::ParallelFor(batches->Count, kernel);
+
+			for (int i = 0; i < batches->Count; i++)
+			{
+				MeshBatch^ batch = batches[i];
+				batch->Positions = Utilities::ToArray(optimizers[i].Positions);
+				if (batch->Normals != nullptr)
+					batch->Normals = Utilities::ToArray(optimizers[i].Normals);
+				if (batch->TexCoords != nullptr)
+					batch->TexCoords = Utilities::ToArray(optimizers[i].TexCoords);
+				batch->Indices = Utilities::ToArray(optimizers[i].Indices);
+				if (batch->FaceIds != nullptr)
+					batch->FaceIds = Utilities::ToArray(optimizers[i].FaceIds);
+				if (batch->MaterialIds != nullptr)
+					batch->MaterialIds = Utilities::ToArray(optimizers[i].MaterialIds);
+				batch->Meshlets = nullptr;
+
+				VertexCacheReport^ report = gcnew VertexCacheReport();
+				report->AcmrBefore = optimizers[i].AcmrBefore;
+				report->AcmrAfter = optimizers[i].AcmrAfter;
+				report->CacheSize = cacheSize;
+				result->Add(report);
+			}
+
+			return result;
+		}
+
+		/// <summary>
+		/// Splits the triangles of every batch into Meshlets, in parallel per batch.
+		/// Call Optimize first to start from a cache friendly triangle order.
+		/// </summary>
+		/// <param name="batches">Batches to split, e.g. Component.MergedMesh of all definitions</param>
+		/// <param name="maxVertices">Largest vertex count of a meshlet, at most 256, e.g. 64</param>
+		/// <param name="maxTriangles">Largest triangle count of a meshlet, e.g. 124</param>
+		static void BuildMeshlets(List<MeshBatch^>^ batches, int maxVertices, int maxTriangles)
+		{
+			if (batches->Count == 0) return;
+
+			std::vector<MeshletBuilder> builders(batches->Count);
+			for (int i = 0; i < batches->Count; i++)
+			{
+				Utilities::FromArray(batches[i]->Positions, builders[i].Positions);
+				Utilities::FromArray(batches[i]->Indices, builders[i].Indices);
+				builders[i].MaxVertices = (std::max)(3, (std::min)(maxVertices, 256));
+				builders[i].MaxTriangles = (std::max)(1, maxTriangles);
+			}
+
+			MeshletKernel kernel;
+			kernel.Builders = &builders[0];
+			Utilities::ParallelFor(batches->Count, kernel);
+
+			for (int i = 0; i < batches->Count; i++)
+				batches[i]->Meshlets = MeshletTable::FromBuilder(builders[i]);
+		}
+
+	internal:
+		/// <summary>
+		/// Material of each triangle if the batch merges several materials, null otherwise.
+		/// Simplify keeps the vertices between materials.
+		/// </summary>
+		array<int>^ MaterialIds;
+
+		/// <summary>
+		/// Soft and smooth edges in the space of Positions, six values per edge, see SmoothNormals
+		/// </summary>
+		array<double>^ SoftEdges;
+
+		static void SetupSimplifier(MeshSimplifier& simplifier, MeshBatch^ batch, int targetTriangles, double maxError)
+		{
+			Utilities::FromArray(batch->Positions, simplifier.Positions);
+			Utilities::FromArray(batch->Normals, simplifier.Normals);
+			Utilities::FromArray(batch->TexCoords, simplifier.TexCoords);
+			Utilities::FromArray(batch->Indices, simplifier.Indices);
+			Utilities::FromArray(batch->MaterialIds, simplifier.MaterialIds);
+			if (batch->FaceIds != nullptr && batch->FaceIds->Length == batch->TriangleCount)
+				Utilities::FromArray(batch->FaceIds, simplifier.FaceIds);
+			simplifier.TargetTriangles = targetTriangles;
+			simplifier.MaxError = maxError;
+			// Batches mixing materials may hold textured ones besides Material
+			simplifier.LockSeams = batch->MaterialIds != nullptr || (batch->Material != nullptr && batch->Material->UsesTexture);
+		}
+
+		static MeshBatch^ FromSimplifier(const MeshSimplifier& simplifier, MeshBatch^ batch)
+		{
+			MeshBatch^ v = gcnew MeshBatch(batch->Name, batch->Layer, batch->Material,
+				Utilities::ToArray(simplifier.OutPositions), Utilities::ToArray(simplifier.OutNormals), Utilities::ToArray(simplifier.OutTexCoords), Utilities::ToArray(simplifier.OutIndices));
+			v->MaterialIds = MixedMaterialIds(simplifier.OutMaterialIds);
+			if (!simplifier.FaceIds.empty())
+			{
+				v->FaceIds = Utilities::ToArray(simplifier.OutFaceIds);
+				v->FacePersistentIds = batch->FacePersistentIds;
+			}
+			v->SoftEdges = batch->SoftEdges;
+			return v;
+		}
+
+		/// <summary>
+		/// Per triangle material ids, or null if all triangles share one material
+		/// </summary>
+		static array<int>^ MixedMaterialIds(const std::vector<int>& ids)
+		{
+			for (size_t t = 1; t < ids.size(); t++)
+			{
+				if (ids[t] != ids[0])
+					return Utilities::ToArray(ids);
+			}
+			return nullptr;
+		}
+
+		static void AppendTransformed(MeshBuffer& buffer, MeshBatch^ batch, const double* transform)
+		{
+			int vCount = batch->VertexCount;
+			int iCount = batch->TriangleCount * 3;
+			if (vCount == 0 || iCount == 0) return;
+
+			double normalMatrix[9];
+			TransformMath::NormalMatrix(transform, normalMatrix);
+			bool flip = TransformMath::Determinant(transform) < 0;
+			bool hasNormals = batch->Normals != nullptr && batch->Normals->Length == 3 * vCount;
+			bool hasTexCoords = batch->TexCoords != nullptr && batch->TexCoords->Length == 2 * vCount;
+
+			pin_ptr<double> positions = &batch->Positions[0];
+			pin_ptr<int> indices = &batch->Indices[0];
+			int offset = (int)(buffer.Positions.size() / 3);
+
+			for (int j = 0; j < vCount; j++)
+			{
+				double p[3];
+				TransformMath::TransformPoint(transform, &positions[3 * j], p);
+				buffer.Positions.push_back(p[0]);
+				buffer.Positions.push_back(p[1]);
+				buffer.Positions.push_back(p[2]);
+			}
+
+			if (hasNormals)
+			{
+				pin_ptr<double> normals = &batch->Normals[0];
+				for (int j = 0; j < vCount; j++)
+				{
+					double n[3];
+					TransformMath::TransformNormal(normalMatrix, &normals[3 * j], n);
+					buffer.Normals.push_back(n[0]);
+					buffer.Normals.push_back(n[1]);
+					buffer.Normals.push_back(n[2]);
+				}
+			}
+			else
+				buffer.Normals.resize(buffer.Normals.size() + 3 * vCount, 0.0);
+
+			if (hasTexCoords)
+			{
+				pin_ptr<double> texCoords = &batch->TexCoords[0];
+				buffer.TexCoords.insert(buffer.TexCoords.end(), &texCoords[0], &texCoords[0] + 2 * vCount);
+			}
+			else
+				buffer.TexCoords.resize(buffer.TexCoords.size() + 2 * vCount, 0.0);
+
+			for (int j = 0; j < iCount; j = j + 3)
+			{
+				buffer.Indices.push_back(offset + indices[j]);
+				buffer.Indices.push_back(offset + indices[flip ? j + 2 : j + 1]);
+				buffer.Indices.push_back(offset + indices[flip ? j + 1 : j + 2]);
+			}
+
+			if (batch->SoftEdges != nullptr && batch->SoftEdges->Length > 0)
+			{
+				pin_ptr<double> softEdges = &batch->SoftEdges[0];
+				for (int j = 0; j + 3 <= batch->SoftEdges->Length; j = j + 3)
+				{
+					double p[3];
+					TransformMath::TransformPoint(transform, &softEdges[j], p);
+					buffer.SoftEdges.push_back(p[0]);
+					buffer.SoftEdges.push_back(p[1]);
+					buffer.SoftEdges.push_back(p[2]);
+				}
+			}
+		}
+
+		static MeshBatch^ FromBuffer(System::String^ name, const MeshBuffer& buffer, System::Collections::Generic::Dictionary<String^, SketchUpNET::Material^>^ materials)
+		{
+			System::String^ materialName = Utilities::GetString(buffer.Material);
+			SketchUpNET::Material^ material = (materials->ContainsKey(materialName)) ? materials[materialName] : nullptr;
+
+			MeshBatch^ v = gcnew MeshBatch(name, Utilities::GetString(buffer.Layer), material,
+				Utilities::ToArray(buffer.Positions), Utilities::ToArray(buffer.Normals), Utilities::ToArray(buffer.TexCoords), Utilities::ToArray(buffer.Indices));
+			v->MaterialIds = MixedMaterialIds(buffer.MaterialIds);
+			v->FaceIds = Utilities::ToArray(buffer.FaceIds);
+			v->FacePersistentIds = Utilities::ToArray(buffer.FacePersistentIds);
+			v->SoftEdges = Utilities::ToArray(buffer.SoftEdges);
+
+			return v;
+		}
+
+		/// <summary>
+		/// Merges all visible faces of entities, including nested groups and instances, into a single local space batch
+		/// </summary>
+		static MeshBatch^ FromEntities(SUEntitiesRef entities, System::String^ name, LoadContext^ context, System::Collections::Generic::Dictionary<String^, SketchUpNET::Material^>^ materials)
+		{
+			double identity[16];
+			TransformMath::Identity(identity);
+			SUMaterialRef material = SU_INVALID;
+			SULayerRef layer = SU_INVALID;
+
+			MeshBatchCollector collector(MeshBatchCollector::All, layer, context);
+			collector.Collect(entities, identity, material, layer);
+
+			if (collector.Buffers.empty())
+				return gcnew MeshBatch(name, System::String::Empty, nullptr, gcnew array<double>(0), gcnew array<double>(0), gcnew array<double>(0), gcnew array<int>(0));
+
+			return MeshBatch::FromBuffer(name, collector.Buffers.begin()->second, materials);
+		}
+
+		static List<MeshBatch^>^ GetModelBatches(SUModelRef model, MeshBatchGrouping grouping, System::Collections::Generic::Dictionary<String^, SketchUpNET::Material^>^ materials)
+		{
+			List<MeshBatch^>^ batches = gcnew List<MeshBatch^>();
+
+			SULayerRef defaultLayer = SU_INVALID;
+			SUModelGetDefaultLayer(model, &defaultLayer);
+
+			SUEntitiesRef entities = SU_INVALID;
+			SUModelGetEntities(model, &entities);
+
+			double identity[16];
+			TransformMath::Identity(identity);
+			SUMaterialRef material = SU_INVALID;
+			SULayerRef layer = SU_INVALID;
+
+			MeshBatchCollector collector((MeshBatchCollector::GroupingMode)(int)grouping, defaultLayer, nullptr);
+			collector.Collect(entities, identity, material, layer);
+
+			for (std::map<std::string, MeshBuffer>::const_iterator it = collector.Buffers.begin(); it != collector.Buffers.end(); ++it)
+			{
+				if (it->second.Indices.empty()) continue;
+				std::string name = (grouping == MeshBatchGrouping::LayerAndMaterial) ? it->second.Layer + "/" + it->second.Material : it->first;
+				batches->Add(MeshBatch::FromBuffer(Utilities::GetString(name), it->second, materials));
+			}
+
+			return batches;
+		}
+
+	};
+
+
+}
@@ -0,0 +1,356 @@
+/*
+
+SketchUpNET - a C++ Wrapper for the Trimble(R) SketchUp(R) C API
+Copyright(C) 2015, Autor: Maximilian Thumfart
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+namespace SketchUpNET
+{
+	/// <summary>
+	/// Reorders triangle buffers for the GPU: triangles by Tipsify for the post transform vertex cache,
+	/// cache clusters by their outward facing for less overdraw, and vertices by first use for vertex fetch.
+	/// Geometry is unchanged.
+	/// </summary>
+	class MeshOptimizer
+	{
+	public:
+		std::vector<double> Positions;
+		std::vector<double> Normals;
+		std::vector<double> TexCoords;
+		std::vector<int> Indices;
+		std::vector<int> FaceIds;
+		std::vector<int> MaterialIds;
+
+		/// <summary>
+		/// Number of vertices the simulated FIFO cache holds
+		/// </summary>
+		int CacheSize;
+
+		/// <summary>
+		/// Average cache misses per triangle of the input and of the result
+		/// </summary>
+		double AcmrBefore;
+		double AcmrAfter;
+
+		void Run()
+		{
+			AcmrBefore = Acmr(Indices, CacheSize);
+
+			std::vector<int> order;
+			Tipsify(order);
+			SortClusters(order);
+
+			std::vector<int> indices(Indices.size());
+			for (size_t i = 0; i < order.size(); i++)
+			{
+				for (int k = 0; k < 3; k++)
+					indices[3 * i + k] = Indices[3 * order[i] + k];
+			}
+			Indices.swap(indices);
+
+			ReorderTriangles(FaceIds, order);
+			ReorderTriangles(MaterialIds, order);
+
+			ReorderVertices();
+			AcmrAfter = Acmr(Indices, CacheSize);
+		}
+
+		/// <summary>
+		/// Average cache misses per triangle for a FIFO cache of the given size, 3 is the worst case
+		/// </summary>
+		static double Acmr(const std::vector<int>& indices, int cacheSize)
+		{
+			if (indices.size() < 3) return 0;
+
+			int vertexCount = 0;
+			for (size_t i = 0; i < indices.size(); i++)
+				vertexCount = (std::max)(vertexCount, indices[i] + 1);
+
+			FifoCache cache(vertexCount, cacheSize);
+			int misses = 0;
+			for (size_t i = 0; i < indices.size(); i++)
+				misses += cache.Access(indices[i]) ? 0 : 1;
+
+			return (double)misses / (indices.size() / 3);
+		}
+
+	private:
+		/// <summary>
+		/// FIFO cache by insertion time, a vertex is cached while fewer than size vertices have been inserted after it
+		/// </summary>
+		struct FifoCache
+		{
+			std::vector<int> Stamps;
+			int Size;
+			int Time;
+
+			FifoCache(int vertexCount, int size) : Stamps(vertexCount, 0), Size(size), Time(size + 1) {}
+
+			bool Access(int vertex)
+			{
+				if (Time - Stamps[vertex] <= Size) return true;
+				Stamps[vertex] = Time++;
+				return false;
+			}
+		};
+
+		/// <summary>
+		/// Tipsify by Sander, Nehab and Barczak: fans around vertices that are likely still in cache
+		/// and restarts from recently used vertices at dead ends. Writes triangle ids in output order.
+		/// </summary>
+		void Tipsify(std::vector<int>& order) const
+		{
+			int vertexCount = (int)(Positions.size() / 3);
+			int triangleCount = (int)(Indices.size() / 3);
+			order.reserve(triangleCount);
+			if (triangleCount == 0) return;
+
+			std::vector<int> offsets(vertexCount + 1, 0);
+			for (size_t i = 0; i < Indices.size(); i++)
+				offsets[Indices[i] + 1]++;
+			for (int v = 0; v < vertexCount; v++)
+				offsets[v + 1] += offsets[v];
+
+			std::vector<int> triangles(Indices.size());
+			std::vector<int> fill(offsets.begin(), offsets.end() - 1);
+			for (size_t i = 0; i < Indices.size(); i++)
+				triangles[fill[Indices[i]]++] = (int)(i / 3);
+
+			std::vector<int> live(vertexCount);
+			for (int v = 0; v < vertexCount; v++)
+				live[v] = offsets[v + 1] - offsets[v];
+
+			std::vector<int> stamps(vertexCount, 0);
+			std::vector<bool> emitted(triangleCount, false);
+			std::vector<int> deadEnds;
+			std::vector<int> candidates;
+			int time = CacheSize + 1;
+			int cursor = 0;
+			int fanning = 0;
+
+			while (fanning >= 0)
+			{
+				candidates.clear();
+				for (int i = offsets[fanning]; i < offsets[fanning + 1]; i++)
+				{
+					int t = triangles[i];
+					if (emitted[t]) continue;
+
+					for (int k = 0; k < 3; k++)
+					{
+						int v = Indices[3 * t + k];
+						deadEnds.push_back(v);
+						candidates.push_back(v);
+						live[v]--;
+						if (time - stamps[v] > CacheSize)
+							stamps[v] = time++;
+					}
+					emitted[t] = true;
+					order.push_back(t);
+				}
+
+				fanning = NextVertex(candidates, deadEnds, live, stamps, time, cursor);
+			}
+		}
+
+		/// <summary>
+		/// Picks the candidate that stays longest in cache while its remaining triangles are emitted,
+		/// falls back to the most recent dead end and then to the next vertex in input order
+		/// </summary>
+		int NextVertex(const std::vector<int>& candidates, std::vector<int>& deadEnds, const std::vector<int>& live, const std::vector<int>& stamps, int time, int& cursor) const
+		{
+			int best = -1;
+			int bestPriority = -1;
+			for (size_t i = 0; i < candidates.size(); i++)
+			{
+				int v = candidates[i];
+				if (live[v] <= 0) continue;
+
+				int priority = (time - stamps[v] + 2 * live[v] <= CacheSize) ? time - stamps[v] : 0;
+				if (priority > bestPriority)
+				{
+					best = v;
+					bestPriority = priority;
+				}
+			}
+			if (best >= 0) return best;
+
+			while (!deadEnds.empty())
+			{
+				int v = deadEnds.back();
+				deadEnds.pop_back();
+				if (live[v] > 0) return v;
+			}
+
+			int vertexCount = (int)live.size();
+			while (cursor < vertexCount && live[cursor] <= 0)
+				cursor++;
+			return (cursor < vertexCount) ? cursor : -1;
+		}
+
+		/// <summary>
+		/// Splits the order into clusters where the cache starts over, i.e. at triangles missing all three vertices,
+		/// and moves clusters facing away from the mesh center to the front so they occlude the inner ones
+		/// </summary>
+		void SortClusters(std::vector<int>& order) const
+		{
+			int vertexCount = (int)(Positions.size() / 3);
+			FifoCache cache(vertexCount, CacheSize);
+			std::vector<int> starts;
+			for (size_t i = 0; i < order.size(); i++)
+			{
+				int misses = 0;
+				for (int k = 0; k < 3; k++)
+					misses += cache.Access(Indices[3 * order[i] + k]) ? 0 : 1;
+				if (i == 0 || misses == 3)
+					starts.push_back((int)i);
+			}
+			starts.push_back((int)order.size());
+
+			int clusterCount = (int)starts.size() - 1;
+			if (clusterCount < 2) return;
+
+			std::vector<double> centroids(3 * clusterCount, 0.0);
+			std::vector<double> normals(3 * clusterCount, 0.0);
+			std::vector<double> areas(clusterCount, 0.0);
+			double center[3] = { 0, 0, 0 };
+			double total = 0;
+
+			for (int c = 0; c < clusterCount; c++)
+			{
+				for (int i = starts[c]; i < starts[c + 1]; i++)
+				{
+					const double* a = &Positions[3 * Indices[3 * order[i]]];
+					const double* b = &Positions[3 * Indices[3 * order[i] + 1]];
+					const double* p = &Positions[3 * Indices[3 * order[i] + 2]];
+					double u[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+					double v[3] = { p[0] - a[0], p[1] - a[1], p[2] - a[2] };
+					double n[3] = { u[1] * v[2] - u[2] * v[1], u[2] * v[0] - u[0] * v[2], u[0] * v[1] - u[1] * v[0] };
+					double area = sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+
+					for (int k = 0; k < 3; k++)
+					{
+						normals[3 * c + k] += n[k];
+						centroids[3 * c + k] += area * (a[k] + b[k] + p[k]) / 3.0;
+					}
+					areas[c] += area;
+				}
+
+				for (int k = 0; k < 3; k++)
+					center[k] += centroids[3 * c + k];
+				total += areas[c];
+			}
+			if (total == 0) return;
+
+			for (int k = 0; k < 3; k++)
+				center[k] /= total;
+
+			std::vector<std::pair<double, int> > keys(clusterCount);
+			for (int c = 0; c < clusterCount; c++)
+			{
+				const double* n = &normals[3 * c];
+				double length = sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+				double facing = 0;
+				if (length > 0 && areas[c] > 0)
+				{
+					for (int k = 0; k < 3; k++)
+						facing += (centroids[3 * c + k] / areas[c] - center[k]) * n[k] / length;
+				}
+				keys[c] = std::make_pair(-facing, c);
+			}
+			std::stable_sort(keys.begin(), keys.end());
+
+			std::vector<int> sorted;
+			sorted.reserve(order.size());
+			for (int i = 0; i < clusterCount; i++)
+			{
+				int c = keys[i].second;
+				sorted.insert(sorted.end(), order.begin() + starts[c], order.begin() + starts[c + 1]);
+			}
+			order.swap(sorted);
+		}
+
+		/// <summary>
+		/// Renumbers vertices in order of first use, unused vertices move to the end
+		/// </summary>
+		void ReorderVertices()
+		{
+			int vertexCount = (int)(Positions.size() / 3);
+			std::vector<int> remap(vertexCount, -1);
+			int next = 0;
+			for (size_t i = 0; i < Indices.size(); i++)
+			{
+				if (remap[Indices[i]] < 0)
+					remap[Indices[i]] = next++;
+			}
+			for (int v = 0; v < vertexCount; v++)
+			{
+				if (remap[v] < 0)
+					remap[v] = next++;
+			}
+
+			for (size_t i = 0; i < Indices.size(); i++)
+				Indices[i] = remap[Indices[i]];
+
+			Permute(Positions, remap, 3);
+			if (Normals.size() == Positions.size()) Permute(Normals, remap, 3);
+			if (TexCoords.size() == 2 * (size_t)vertexCount) Permute(TexCoords, remap, 2);
+		}
+
+		/// <summary>
+		/// Reorders per triangle values, unless they don't match the triangle count
+		/// </summary>
+		static void ReorderTriangles(std::vector<int>& values, const std::vector<int>& order)
+		{
+			if (values.size() != order.size()) return;
+
+			std::vector<int> result(values.size());
+			for (size_t i = 0; i < order.size(); i++)
+				result[i] = values[order[i]];
+			values.swap(result);
+		}
+
+		static void Permute(std::vector<double>& values, const std::vector<int>& remap, int stride)
+		{
+			std::vector<double> result(values.size());
+			for (size_t v = 0; v < remap.size(); v++)
+			{
+				for (int k = 0; k < stride; k++)
+					result[stride * remap[v] + k] = values[stride * v + k];
+			}
+			values.swap(result);
+		}
+	};
+
+	struct OptimizeKernel
+	{
+		MeshOptimizer* Optimizers;
+
+		void operator()(int index) const
+		{
+			Optimizers[index].Run();
+		}
+	};
+
+
+}
@@ -0,0 +1,374 @@
+/*
+
+SketchUpNET - a C++ Wrapper for the Trimble(R) SketchUp(R) C API
+Copyright(C) 2015, Autor: Maximilian Thumfart
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+#pragma once
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include "utilities.h"
+
+using namespace System;
+using namespace System::Collections;
+using namespace System::Collections::Generic;
+
+namespace SketchUpNET
+{
+	/// <summary>
+	/// Splits a triangle buffer into meshlets of limited vertex and triangle count.
+	/// Meshlets grow over shared vertices, preferring triangles that add the fewest new vertices,
+	/// and continue with the next unused triangle in buffer order once no neighbor is left.
+	/// </summary>
+	class MeshletBuilder
+	{
+	public:
+		std::vector<double> Positions;
+		std::vector<int> Indices;
+		int MaxVertices;
+		int MaxTriangles;
+
+		std::vector<int> VertexOffsets;
+		std::vector<int> Vertices;
+		std::vector<int> TriangleOffsets;
+		std::vector<unsigned char> Triangles;
+		std::vector<double> Centers;
+		std::vector<double> Radii;
+		std::vector<double> ConeApexes;
+		std::vector<double> ConeAxes;
+		std::vector<double> ConeCutoffs;
+
+		void Run()
+		{
+			int vertexCount = (int)(Positions.size() / 3);
+			int triangleCount = (int)(Indices.size() / 3);
+			VertexOffsets.assign(1, 0);
+			TriangleOffsets.assign(1, 0);
+
+			std::vector<int> offsets(vertexCount + 1, 0);
+			for (size_t i = 0; i < Indices.size(); i++)
+				offsets[Indices[i] + 1]++;
+			for (int v = 0; v < vertexCount; v++)
+				offsets[v + 1] += offsets[v];
+
+			std::vector<int> adjacent(Indices.size());
+			std::vector<int> fill(offsets.begin(), offsets.end() - 1);
+			for (size_t i = 0; i < Indices.size(); i++)
+				adjacent[fill[Indices[i]]++] = (int)(i / 3);
+
+			std::vector<bool> used(triangleCount, false);
+			local.assign(vertexCount, -1);
+			int seed = 0;
+
+			while (true)
+			{
+				int best = -1;
+				int bestNew = 4;
+				size_t kept = 0;
+				for (size_t i = 0; i < candidates.size(); i++)
+				{
+					int t = candidates[i];
+					if (used[t]) continue;
+					candidates[kept++] = t;
+
+					int added = NewVertices(t);
+					if (added < bestNew)
+					{
+						best = t;
+						bestNew = added;
+					}
+				}
+				candidates.resize(kept);
+
+				if (best < 0)
+				{
+					while (seed < triangleCount && used[seed])
+						seed++;
+					if (seed == triangleCount) break;
+					best = seed;
+					bestNew = NewVertices(best);
+				}
+
+				if ((int)meshletVertices.size() + bestNew > MaxVertices || (int)meshletTriangles.size() / 3 >= MaxTriangles)
+				{
+					Flush();
+					continue;
+				}
+
+				used[best] = true;
+				for (int k = 0; k < 3; k++)
+				{
+					int v = Indices[3 * best + k];
+					if (local[v] < 0)
+					{
+						local[v] = (int)meshletVertices.size();
+						meshletVertices.push_back(v);
+					}
+					meshletTriangles.push_back((unsigned char)local[v]);
+
+					for (int i = offsets[v]; i < offsets[v + 1]; i++)
+					{
+						if (!used[adjacent[i]])
+							candidates.push_back(adjacent[i]);
+					}
+				}
+			}
+
+			if (!meshletTriangles.empty())
+				Flush();
+		}
+
+	private:
+		std::vector<int> local;
+		std::vector<int> meshletVertices;
+		std::vector<unsigned char> meshletTriangles;
+		std::vector<int> candidates;
+
+		/// <summary>
+		/// Number of vertices of a triangle not yet in the current meshlet
+		/// </summary>
+		int NewVertices(int t) const
+		{
+			int a = Indices[3 * t], b = Indices[3 * t + 1], c = Indices[3 * t + 2];
+			int added = (local[a] < 0) ? 1 : 0;
+			if (local[b] < 0 && b != a) added++;
+			if (local[c] < 0 && c != a && c != b) added++;
+			return added;
+		}
+
+		/// <summary>
+		/// Stores the current meshlet with its bounding sphere and normal cone and starts a new one
+		/// </summary>
+		void Flush()
+		{
+			Vertices.insert(Vertices.end(), meshletVertices.begin(), meshletVertices.end());
+			Triangles.insert(Triangles.end(), meshletTriangles.begin(), meshletTriangles.end());
+			VertexOffsets.push_back((int)Vertices.size());
+			TriangleOffsets.push_back((int)(Triangles.size() / 3));
+
+			double min[3] = { HUGE_VAL, HUGE_VAL, HUGE_VAL };
+			double max[3] = { -HUGE_VAL, -HUGE_VAL, -HUGE_VAL };
+			for (size_t i = 0; i < meshletVertices.size(); i++)
+			{
+				for (int k = 0; k < 3; k++)
+				{
+					min[k] = (std::min)(min[k], Positions[3 * meshletVertices[i] + k]);
+					max[k] = (std::max)(max[k], Positions[3 * meshletVertices[i] + k]);
+				}
+			}
+
+			double center[3] = { (min[0] + max[0]) / 2, (min[1] + max[1]) / 2, (min[2] + max[2]) / 2 };
+			double radius = 0;
+			for (size_t i = 0; i < meshletVertices.size(); i++)
+				radius = (std::max)(radius, Distance(&Positions[3 * meshletVertices[i]], center));
+
+			int triangleCount = (int)(meshletTriangles.size() / 3);
+			std::vector<double> normals(3 * triangleCount, 0.0);
+			std::vector<bool> valid(triangleCount, false);
+			double axis[3] = { 0, 0, 0 };
+			for (int t = 0; t < triangleCount; t++)
+			{
+				const double* a = Corner(t, 0);
+				const double* b = Corner(t, 1);
+				const double* c = Corner(t, 2);
+				double u[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+				double v[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+				double* n = &normals[3 * t];
+				n[0] = u[1] * v[2] - u[2] * v[1];
+				n[1] = u[2] * v[0] - u[0] * v[2];
+				n[2] = u[0] * v[1] - u[1] * v[0];
+				valid[t] = Normalize(n);
+				for (int k = 0; k < 3; k++)
+					axis[k] += n[k];
+			}
+
+			// Cones wider than about 84 degrees can't cull anything and get a cutoff of 1
+			double cutoff = 1;
+			double apex[3] = { center[0], center[1], center[2] };
+			if (Normalize(axis))
+			{
+				double minDot = 1;
+				for (int t = 0; t < triangleCount; t++)
+				{
+					if (valid[t])
+						minDot = (std::min)(minDot, Dot(axis, &normals[3 * t]));
+				}
+
+				if (minDot > 0.1)
+				{
+					// Moves the apex back along the axis until it lies behind every triangle plane
+					double maxT = 0;
+					for (int t = 0; t < triangleCount; t++)
+					{
+						if (!valid[t]) continue;
+						const double* a = Corner(t, 0);
+						double offset[3] = { center[0] - a[0], center[1] - a[1], center[2] - a[2] };
+						maxT = (std::max)(maxT, Dot(offset, &normals[3 * t]) / Dot(axis, &normals[3 * t]));
+					}
+
+					for (int k = 0; k < 3; k++)
+						apex[k] = center[k] - axis[k] * maxT;
+					cutoff = sqrt(1 - minDot * minDot);
+				}
+			}
+
+			Centers.insert(Centers.end(), center, center + 3);
+			Radii.push_back(radius);
+			ConeApexes.insert(ConeApexes.end(), apex, apex + 3);
+			ConeAxes.insert(ConeAxes.end(), axis, axis + 3);
+			ConeCutoffs.push_back(cutoff);
+
+			for (size_t i = 0; i < meshletVertices.size(); i++)
+				local[meshletVertices[i]] = -1;
+			meshletVertices.clear();
+			meshletTriangles.clear();
+			candidates.clear();
+		}
+
+		const double* Corner(int t, int k) const
+		{
+			return &Positions[3 * meshletVertices[meshletTriangles[3 * t + k]]];
+		}
+
+		static double Dot(const double* a, const double* b)
+		{
+			return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+		}
+
+		static double Distance(const double* a, const double* b)
+		{
+			double d[3] = { a[0] - b[0], a[1] - b[1], a[2] - b[2] };
+			return sqrt(Dot(d, d));
+		}
+
+		static bool Normalize(double* v)
+		{
+			double length = sqrt(Dot(v, v));
+			if (length == 0) return false;
+			v[0] /= length;
+			v[1] /= length;
+			v[2] /= length;
+			return true;
+		}
+	};
+
+	struct MeshletKernel
+	{
+		MeshletBuilder* Builders;
+
+		void operator()(int index) const
+		{
+			Builders[index].Run();
+		}
+	};
+
+	/// <summary>
+	/// Meshlets of a MeshBatch stored in flat buffers for cluster based culling.
+	/// Meshlet i uses the batch vertices Vertices[VertexOffsets[i]] to Vertices[VertexOffsets[i + 1] - 1]
+	/// and the triangles TriangleOffsets[i] to TriangleOffsets[i + 1] - 1, which index into those vertices.
+	/// </summary>
+	public ref class MeshletTable
+	{
+	public:
+		/// <summary>
+		/// Index of the first vertex of each meshlet in Vertices, followed by the total count
+		/// </summary>
+		array<int>^ VertexOffsets;
+
+		/// <summary>
+		/// Batch vertex indices of all meshlets
+		/// </summary>
+		array<int>^ Vertices;
+
+		/// <summary>
+		/// Index of the first triangle of each meshlet, followed by the total count
+		/// </summary>
+		array<int>^ TriangleOffsets;
+
+		/// <summary>
+		/// Meshlet local vertex indices, three per triangle
+		/// </summary>
+		array<Byte>^ Triangles;
+
+		/// <summary>
+		/// Bounding sphere centers in meters as x,y,z triplets
+		/// </summary>
+		array<double>^ Centers;
+
+		/// <summary>
+		/// Bounding sphere radii in meters
+		/// </summary>
+		array<double>^ Radii;
+
+		/// <summary>
+		/// Normal cone apexes as x,y,z triplets. A meshlet faces away from a camera at position c
+		/// if dot(normalize(apex - c), axis) >= cutoff.
+		/// </summary>
+		array<double>^ ConeApexes;
+
+		/// <summary>
+		/// Normal cone axes as x,y,z triplets
+		/// </summary>
+		array<double>^ ConeAxes;
+
+		/// <summary>
+		/// Sine of the normal cone angle, 1 for meshlets that can't be back face culled
+		/// </summary>
+		array<double>^ ConeCutoffs;
+
+		property int Count
+		{
+			int get() { return (Radii == nullptr) ? 0 : Radii->Length; }
+		}
+
+		MeshletTable(){};
+
+		int GetVertexCount(int meshlet)
+		{
+			return VertexOffsets[meshlet + 1] - VertexOffsets[meshlet];
+		}
+
+		int GetTriangleCount(int meshlet)
+		{
+			return TriangleOffsets[meshlet + 1] - TriangleOffsets[meshlet];
+		}
+
+	internal:
+		static MeshletTable^ FromBuilder(const MeshletBuilder& builder)
+		{
+			MeshletTable^ table = gcnew MeshletTable();
+			table->VertexOffsets = Utilities::ToArray(builder.VertexOffsets);
+			table->Vertices = Utilities::ToArray(builder.Vertices);
+			table->TriangleOffsets = Utilities::ToArray(builder.TriangleOffsets);
+			table->Centers = Utilities::ToArray(builder.Centers);
+			table->Radii = Utilities::ToArray(builder.Radii);
+			table->ConeApexes = Utilities::ToArray(builder.ConeApexes);
+			table->ConeAxes = Utilities::ToArray(builder.ConeAxes);
+			table->ConeCutoffs = Utilities::ToArray(builder.ConeCutoffs);
+
+			table->Triangles = gcnew array<Byte>((int)builder.Triangles.size());
+			if (!builder.Triangles.empty())
+				System::Runtime::InteropServices::Marshal::Copy(System::IntPtr((void*)&builder.Triangles[0]), table->Triangles, 0, table->Triangles->Length);
+
+			return table;
+		}
+	};
+
+
+}
@@ -0,0 +1,309 @@
+/*
+
+SketchUpNET - a C++ Wrapper for the Trimble(R) SketchUp(R) C API
+Copyright(C) 2015, Autor: Maximilian Thumfart
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <SketchUpAPI/slapi.h>
+#include <SketchUpAPI/initialize.h>
+#include <SketchUpAPI/unicodestring.h>
+#include <SketchUpAPI/model/model.h>
+#include <SketchUpAPI/model/entity.h>
+#include <SketchUpAPI/model/face.h>
+#include <SketchUpAPI/model/edge.h>
+#include <SketchUpAPI/model/group.h>
+#include <SketchUpAPI/model/component_definition.h>
+#include <SketchUpAPI/model/component_instance.h>
+#include <SketchUpAPI/model/instancepath.h>
+#include <SketchUpAPI/model/image.h>
+#include <vector>
+#include "utilities.h"
+#include "Transform.h"
+#include "LoadContext.h"
+#include "Surface.h"
+#include "Edge.h"
+#include "Instance.h"
+#include "Group.h"
+#include "Component.h"
+#include "Image.h"
+
+using namespace System;
+using namespace System::Collections;
+using namespace System::Collections::Generic;
+
+namespace SketchUpNET
+{
+	/// <summary>
+	/// Entity read from an open model by persistent id or persistent id path
+	/// </summary>
+	public ref class FetchedEntity
+	{
+	public:
+		/// <summary>
+		/// Persistent id of the entity
+		/// </summary>
+		Int64 PersistentId;
+
+		/// <summary>
+		/// Persistent id path, e.g. "12.34.56", if fetched by path
+		/// </summary>
+		System::String^ Path;
+
+		/// <summary>
+		/// Surface, Edge, Instance, Group, Component or Image, null if the id hasn't been found or is of another type
+		/// </summary>
+		System::Object^ Entity;
+
+		/// <summary>
+		/// World transformation of the instance path, null if fetched by id
+		/// </summary>
+		Transform^ Transformation;
+
+		FetchedEntity(){};
+	};
+
+	/// <summary>
+	/// Keeps a model open to read single entities on demand instead of loading the whole model.
+	/// Dispose the session to release the model.
+	/// </summary>
+	public ref class ModelSession
+	{
+	public:
+		/// <summary>
+		/// Options used to read fetched entities
+		/// </summary>
+		LoadOptions^ Options;
+
+		/// <summary>
+		/// Opens a model, returns null if it can't be read
+		/// </summary>
+		/// <param name="filename">Path to .skp file</param>
+		static ModelSession^ Open(System::String^ filename)
+		{
+			const char* path = Utilities::ToString(filename);
+
+			SUInitialize();
+
+			SUModelRef model = SU_INVALID;
+			SUModelLoadStatus status;
+			SUResult res = SUModelCreateFromFileWithStatus(&model, path, &status);
+			delete[] path;
+
+			if (res != SU_ERROR_NONE)
+			{
+				SUTerminate();
+				return nullptr;
+			}
+
+			return gcnew ModelSession(model);
+		}
+
+		~ModelSession()
+		{
+			this->!ModelSession();
+		}
+
+		!ModelSession()
+		{
+			if (model == NULL) return;
+
+			SUModelRelease(model);
+			delete model;
+			model = NULL;
+			SUTerminate();
+		}
+
+		/// <summary>
+		/// Reads entities by persistent id in the order of the ids, looking only at definition entities and definitions.
+		/// Entities are returned in the coordinates of their parent, see FetchPaths for world transformations.
+		/// </summary>
+		/// <param name="pids">Persistent ids, e.g. from SketchUp.PersistentIndex or an AttributeTable</param>
+		List<FetchedEntity^>^ Fetch(array<Int64>^ pids)
+		{
+			List<FetchedEntity^>^ result = gcnew List<FetchedEntity^>(pids->Length);
+			if (model == NULL || pids->Length == 0) return result;
+
+			std::vector<int64_t> ids(pids->Length);
+			for (int i = 0; i < pids->Length; i++)
+				ids[i] = pids[i];
+
+			std::vector<SUEntityRef> entities(ids.size());
+			for (size_t i = 0; i < entities.size(); i++)
+				SUSetInvalid(entities[i]);
+
+			SUModelGetEntitiesOfTypeByPersistentIDs(*model, FLAG_GET_ENTITIES_TYPE_DEFINITION_ENTITIES | FLAG_GET_ENTITIES_TYPE_DEFINITIONS, ids.size(), &ids[0], &entities[0]);
+
+			for (int i = 0; i < pids->Length; i++)
+			{
+				FetchedEntity^ fetched = gcnew FetchedEntity();
+				fetched->PersistentId = pids[i];
+				if (!SUIsInvalid(entities[i]))
+					fetched->Entity = ToObject(entities[i]);
+				result->Add(fetched);
+			}
+
+			return result;
+		}
+
+		/// <summary>
+		/// Reads entities by persistent id path, from the outermost instance or group to the entity, separated by dots.
+		/// Each entity is returned with the world transformation of its path.
+		/// </summary>
+		/// <param name="paths">Persistent id paths, a single id for entities of the model root</param>
+		List<FetchedEntity^>^ FetchPaths(array<System::String^>^ paths)
+		{
+			List<FetchedEntity^>^ result = gcnew List<FetchedEntity^>(paths->Length);
+			if (model == NULL) return result;
+
+			for each (System::String^ pidPath in paths)
+			{
+				FetchedEntity^ fetched = gcnew FetchedEntity();
+				fetched->Path = pidPath;
+				result->Add(fetched);
+
+				const char* text = Utilities::ToString(pidPath);
+				SUStringRef pid = SU_INVALID;
+				SUStringCreateFromUTF8(&pid, text);
+				delete[] text;
+
+				SUInstancePathRef instancePath = SU_INVALID;
+				SUInstancePathCreate(&instancePath);
+				SUResult res = SUModelGetInstancePathByPid(*model, pid, &instancePath);
+				SUStringRelease(&pid);
+
+				if (res == SU_ERROR_NONE)
+				{
+					SUEntityRef leaf = SU_INVALID;
+					SUInstancePathGetLeafAsEntity(instancePath, &leaf);
+
+					SUTransformation transform;
+					SUInstancePathGetTransform(instancePath, &transform);
+
+					if (!SUIsInvalid(leaf))
+					{
+						fetched->PersistentId = Utilities::GetPersistentId(leaf);
+						fetched->Entity = ToObject(leaf);
+					}
+					fetched->Transformation = Transform::FromSU(transform);
+				}
+
+				SUInstancePathRelease(&instancePath);
+			}
+
+			return result;
+		}
+
+		/// <summary>
+		/// Decodes the pixels of an image entity on first request.
+		/// Results are cached, images with equal content share one ImagePixels instance.
+		/// Returns null if the image hasn't been found or holds no data.
+		/// </summary>
+		/// <param name="image">Image loaded from the same file</param>
+		ImagePixels^ GetPixels(Image^ image)
+		{
+			return GetPixels(image->PersistentId);
+		}
+
+		/// <summary>
+		/// Decodes the pixels of an image entity by persistent id, see GetPixels(Image)
+		/// </summary>
+		ImagePixels^ GetPixels(Int64 pid)
+		{
+			if (model == NULL) return nullptr;
+			if (pixelsById->ContainsKey(pid)) return pixelsById[pid];
+
+			int64_t id = pid;
+			SUEntityRef entity = SU_INVALID;
+			SUModelGetEntitiesOfTypeByPersistentIDs(*model, FLAG_GET_ENTITIES_TYPE_DEFINITION_ENTITIES, 1, &id, &entity);
+
+			ImagePixels^ pixels = nullptr;
+			if (!SUIsInvalid(entity) && SUEntityGetType(entity) == SURefType_Image)
+				pixels = ImagePixels::FromSU(SUImageFromEntity(entity));
+
+			if (pixels != nullptr)
+			{
+				List<ImagePixels^>^ bucket = nullptr;
+				if (!pixelsByHash->TryGetValue(pixels->Hash, bucket))
+				{
+					bucket = gcnew List<ImagePixels^>();
+					pixelsByHash->Add(pixels->Hash, bucket);
+				}
+
+				ImagePixels^ shared = nullptr;
+				for each (ImagePixels^ candidate in bucket)
+				{
+					if (candidate->SameContent(pixels))
+					{
+						shared = candidate;
+						break;
+					}
+				}
+
+				if (shared == nullptr)
+					bucket->Add(pixels);
+				else
+					pixels = shared;
+			}
+
+			pixelsById->Add(pid, pixels);
+			return pixels;
+		}
+
+	internal:
+		ModelSession(SUModelRef model)
+		{
+			this->model = new SUModelRef(model);
+			this->materials = gcnew Dictionary<String^, Material^>();
+			this->Options = gcnew LoadOptions();
+			this->pixelsById = gcnew Dictionary<Int64, ImagePixels^>();
+			this->pixelsByHash = gcnew Dictionary<UInt64, List<ImagePixels^>^>();
+		};
+
+		System::Object^ ToObject(SUEntityRef entity)
+		{
+			LoadContext^ context = gcnew LoadContext(Options);
+			switch (SUEntityGetType(entity))
+			{
+			case SURefType_Face:
+				return Surface::FromSU(SUFaceFromEntity(entity), context, materials);
+			case SURefType_Edge:
+				return Edge::FromSU(SUEdgeFromEntity(entity));
+			case SURefType_ComponentInstance:
+				return Instance::FromSU(SUComponentInstanceFromEntity(entity), materials);
+			case SURefType_Group:
+				return Group::FromSU(SUGroupFromEntity(entity), context, materials);
+			case SURefType_ComponentDefinition:
+				return Component::FromSU(SUComponentDefinitionFromEntity(entity), context, materials);
+			case SURefType_Image:
+				return Image::FromSU(SUImageFromEntity(entity));
+			default:
+				return nullptr;
+			}
+		}
+
+	private:
+		SUModelRef* model;
+		Dictionary<String^, Material^>^ materials;
+		Dictionary<Int64, ImagePixels^>^ pixelsById;
+		Dictionary<UInt64, List<ImagePixels^>^>^ pixelsByHash;
+	};
+
+
+}
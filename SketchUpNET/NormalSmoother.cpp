@@ -0,0 +1,328 @@
+/*
+
+SketchUpNET - a C++ Wrapper for the Trimble(R) SketchUp(R) C API
+Copyright(C) 2015, Autor: Maximilian Thumfart
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+#pragma once
+
+#include <vector>
+#include <map>
+#include <set>
+#include <utility>
+#include <algorithm>
+#include <cmath>
+
+namespace SketchUpNET
+{
+	/// <summary>
+	/// Smooth vertex normals for flat triangle buffers. Vertices are welded by position and each vertex
+	/// averages the area weighted normals of the welded triangles within the crease angle of its own faces.
+	/// Faces meeting at a smaller angle blend and sharper creases stay split, except across soft edges,
+	/// where faces always blend.
+	/// </summary>
+	class NormalSmoother
+	{
+	public:
+		std::vector<double> Positions;
+		std::vector<int> Indices;
+
+		/// <summary>
+		/// Cosine of the crease angle
+		/// </summary>
+		double CosCrease;
+
+		/// <summary>
+		/// Soft and smooth edges as start and end point, six values per edge. Optional.
+		/// </summary>
+		std::vector<double> SoftEdges;
+
+		/// <summary>
+		/// Source face of each triangle, joins the triangles of a face across soft edges. Optional.
+		/// </summary>
+		std::vector<int> FaceIds;
+
+		/// <summary>
+		/// Receives one unit normal per vertex as x,y,z triplets, vertices of degenerate triangles only keep their input normal
+		/// </summary>
+		std::vector<double> Normals;
+
+		/// <summary>
+		/// Computes face normals and the welded adjacency, Smooth then runs per vertex
+		/// </summary>
+		void Prepare()
+		{
+			int vertexCount = (int)(Positions.size() / 3);
+			int triangleCount = (int)(Indices.size() / 3);
+			if (Normals.size() != Positions.size())
+				Normals.assign(Positions.size(), 0.0);
+
+			faceNormals.assign(3 * (size_t)triangleCount, 0.0);
+			for (int t = 0; t < triangleCount; t++)
+			{
+				const double* a = &Positions[3 * Indices[3 * t]];
+				const double* b = &Positions[3 * Indices[3 * t + 1]];
+				const double* c = &Positions[3 * Indices[3 * t + 2]];
+				double u[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+				double v[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+				faceNormals[3 * t] = u[1] * v[2] - u[2] * v[1];
+				faceNormals[3 * t + 1] = u[2] * v[0] - u[0] * v[2];
+				faceNormals[3 * t + 2] = u[0] * v[1] - u[1] * v[0];
+			}
+
+			std::map<Key, int> ids;
+			welded.resize(vertexCount);
+			for (int i = 0; i < vertexCount; i++)
+			{
+				Key key = { Positions[3 * i], Positions[3 * i + 1], Positions[3 * i + 2] };
+				std::map<Key, int>::iterator it = ids.find(key);
+				if (it == ids.end())
+					it = ids.insert(std::make_pair(key, (int)ids.size())).first;
+				welded[i] = it->second;
+			}
+
+			BuildAdjacency(vertexOffsets, vertexTriangles, vertexCount, false);
+			BuildAdjacency(pointOffsets, pointTriangles, (int)ids.size(), true);
+			BuildSoftGroups(ids);
+		}
+
+		/// <summary>
+		/// Writes the normal of one vertex, vertices are independent of each other
+		/// </summary>
+		void Smooth(int vertex)
+		{
+			double reference[3] = { 0, 0, 0 };
+			for (int i = vertexOffsets[vertex]; i < vertexOffsets[vertex + 1]; i++)
+				Add(reference, vertexTriangles[i]);
+
+			if (!Normalize(reference)) return;
+
+			double sum[3] = { 0, 0, 0 };
+			int point = welded[vertex];
+			for (int i = pointOffsets[point]; i < pointOffsets[point + 1]; i++)
+			{
+				const double* n = &faceNormals[3 * pointTriangles[i]];
+				double length = sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+				if (length == 0) continue;
+
+				double cosine = (n[0] * reference[0] + n[1] * reference[1] + n[2] * reference[2]) / length;
+				if (cosine >= CosCrease || SoftlyJoined(vertex, pointTriangles[i]))
+					Add(sum, pointTriangles[i]);
+			}
+
+			if (!Normalize(sum))
+			{
+				sum[0] = reference[0];
+				sum[1] = reference[1];
+				sum[2] = reference[2];
+			}
+
+			Normals[3 * vertex] = sum[0];
+			Normals[3 * vertex + 1] = sum[1];
+			Normals[3 * vertex + 2] = sum[2];
+		}
+
+	private:
+		struct Key
+		{
+			double X, Y, Z;
+
+			bool operator<(const Key& other) const
+			{
+				if (X != other.X) return X < other.X;
+				if (Y != other.Y) return Y < other.Y;
+				return Z < other.Z;
+			}
+		};
+
+		std::vector<double> faceNormals;
+		std::vector<int> welded;
+		std::vector<int> vertexOffsets;
+		std::vector<int> vertexTriangles;
+		std::vector<int> pointOffsets;
+		std::vector<int> pointTriangles;
+
+		/// <summary>
+		/// Triangles joined by soft edges share a group, empty without soft edges
+		/// </summary>
+		std::vector<int> softGroups;
+
+		/// <summary>
+		/// Groups the triangles of each face, and of faces sharing a soft edge, by union find
+		/// </summary>
+		void BuildSoftGroups(const std::map<Key, int>& ids)
+		{
+			softGroups.clear();
+
+			std::set<std::pair<int, int> > soft;
+			for (size_t e = 0; e + 6 <= SoftEdges.size(); e += 6)
+			{
+				Key start = { SoftEdges[e], SoftEdges[e + 1], SoftEdges[e + 2] };
+				Key end = { SoftEdges[e + 3], SoftEdges[e + 4], SoftEdges[e + 5] };
+				std::map<Key, int>::const_iterator a = ids.find(start);
+				std::map<Key, int>::const_iterator b = ids.find(end);
+				if (a == ids.end() || b == ids.end() || a->second == b->second) continue;
+				soft.insert(EdgeKey(a->second, b->second));
+			}
+			if (soft.empty()) return;
+
+			int triangleCount = (int)(Indices.size() / 3);
+			bool hasFaces = FaceIds.size() == (size_t)triangleCount;
+			softGroups.resize(triangleCount);
+			for (int t = 0; t < triangleCount; t++)
+				softGroups[t] = t;
+
+			std::map<int, int> faceTriangles;
+			std::map<std::pair<int, int>, int> edgeTriangles;
+			for (int t = 0; t < triangleCount; t++)
+			{
+				if (hasFaces)
+				{
+					std::pair<std::map<int, int>::iterator, bool> face = faceTriangles.insert(std::make_pair(FaceIds[t], t));
+					if (!face.second) Join(face.first->second, t);
+				}
+
+				for (int k = 0; k < 3; k++)
+				{
+					std::pair<int, int> edge = EdgeKey(welded[Indices[3 * t + k]], welded[Indices[3 * t + (k + 1) % 3]]);
+					if (edge.first == edge.second || soft.find(edge) == soft.end()) continue;
+
+					std::pair<std::map<std::pair<int, int>, int>::iterator, bool> shared = edgeTriangles.insert(std::make_pair(edge, t));
+					if (!shared.second) Join(shared.first->second, t);
+				}
+			}
+
+			for (int t = 0; t < triangleCount; t++)
+				softGroups[t] = Root(t);
+		}
+
+		static std::pair<int, int> EdgeKey(int a, int b)
+		{
+			return (a < b) ? std::make_pair(a, b) : std::make_pair(b, a);
+		}
+
+		int Root(int t)
+		{
+			while (softGroups[t] != t)
+			{
+				softGroups[t] = softGroups[softGroups[t]];
+				t = softGroups[t];
+			}
+			return t;
+		}
+
+		void Join(int a, int b)
+		{
+			a = Root(a);
+			b = Root(b);
+			if (a != b) softGroups[(std::max)(a, b)] = (std::min)(a, b);
+		}
+
+		/// <summary>
+		/// A triangle is joined to one of the vertex's own triangles by soft edges
+		/// </summary>
+		bool SoftlyJoined(int vertex, int triangle) const
+		{
+			if (softGroups.empty()) return false;
+
+			for (int i = vertexOffsets[vertex]; i < vertexOffsets[vertex + 1]; i++)
+			{
+				if (softGroups[vertexTriangles[i]] == softGroups[triangle])
+					return true;
+			}
+			return false;
+		}
+
+		/// <summary>
+		/// Lists the triangles of each vertex, or of each welded point, as offsets into one array
+		/// </summary>
+		void BuildAdjacency(std::vector<int>& offsets, std::vector<int>& triangles, int count, bool weld)
+		{
+			int triangleCount = (int)(Indices.size() / 3);
+			offsets.assign(count + 1, 0);
+			for (int t = 0; t < triangleCount; t++)
+			{
+				for (int k = 0; k < 3; k++)
+				{
+					if (Repeats(t, k, weld)) continue;
+					offsets[Target(Indices[3 * t + k], weld) + 1]++;
+				}
+			}
+
+			for (int i = 0; i < count; i++)
+				offsets[i + 1] += offsets[i];
+
+			triangles.resize(offsets[count]);
+			std::vector<int> fill(offsets.begin(), offsets.end() - 1);
+			for (int t = 0; t < triangleCount; t++)
+			{
+				for (int k = 0; k < 3; k++)
+				{
+					if (Repeats(t, k, weld)) continue;
+					triangles[fill[Target(Indices[3 * t + k], weld)]++] = t;
+				}
+			}
+		}
+
+		int Target(int vertex, bool weld) const
+		{
+			return weld ? welded[vertex] : vertex;
+		}
+
+		/// <summary>
+		/// Corner k of triangle t refers to the same vertex or point as an earlier corner
+		/// </summary>
+		bool Repeats(int t, int k, bool weld) const
+		{
+			for (int j = 0; j < k; j++)
+			{
+				if (Target(Indices[3 * t + j], weld) == Target(Indices[3 * t + k], weld))
+					return true;
+			}
+			return false;
+		}
+
+		void Add(double* sum, int triangle) const
+		{
+			sum[0] += faceNormals[3 * triangle];
+			sum[1] += faceNormals[3 * triangle + 1];
+			sum[2] += faceNormals[3 * triangle + 2];
+		}
+
+		static bool Normalize(double* v)
+		{
+			double length = sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+			if (length == 0) return false;
+			v[0] /= length;
+			v[1] /= length;
+			v[2] /= length;
+			return true;
+		}
+	};
+
+	struct SmoothNormalsKernel
+	{
+		NormalSmoother* Smoother;
+
+		void operator()(int vertex) const
+		{
+			Smoother->Smooth(vertex);
+		}
+	};
+
+
+}
@@ -1,98 +1,107 @@
 /*
 
-SketchUpSharp - a managed C++ Wrapper for the SketchUp C API
+SketchUpNET - a C++ Wrapper for the Trimble(R) SketchUp(R) C API
 Copyright(C) 2015, Autor: Maximilian Thumfart
 
-This program is free software : you can redistribute it and / or modify
-it under the terms of the GNU General Public License as published by
-the Free Software Foundation, either version 3 of the License, or
-any later version.
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
 
-This program is distributed in the hope that it will be useful,
-but WITHOUT ANY WARRANTY; without even the implied warranty of
-MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
-GNU General Public License for more details.
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
 
-You should have received a copy of the GNU General Public License
-along with this program.If not, see <http://www.gnu.org/licenses/>.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 */
+#pragma once
 
-#include <slapi/slapi.h>
-#include <slapi/geometry.h>
-#include <slapi/initialize.h>
-#include <slapi/unicodestring.h>
-#include <slapi/model/model.h>
-#include <slapi/model/entities.h>
-#include <slapi/model/face.h>
-#include <slapi/model/edge.h>
-#include <slapi/model/vertex.h>
-#include <slapi/model/opening.h>
-#include <msclr/marshal.h>
+#include <SketchUpAPI/slapi.h>
+#include <SketchUpAPI/geometry.h>
+#include <SketchUpAPI/model/face.h>
+#include <SketchUpAPI/model/component_definition.h>
+#include <SketchUpAPI/model/opening.h>
 #include <vector>
-#include "Corner.h"
-#include "Layer.h"
-
-#pragma once
+#include "utilities.h"
+#include "PointRings.h"
 
 using namespace System;
 using namespace System::Collections;
 using namespace System::Collections::Generic;
 
-namespace SketchUpSharp
+namespace SketchUpNET
 {
-	public ref class Loop
+	/// <summary>
+	/// Reads openings cut by glued components, e.g. windows and doors, as point rings
+	/// </summary>
+	private ref class Opening
 	{
-	public:
+	internal:
+		/// <summary>
+		/// Openings cut into a face, one ring per opening
+		/// </summary>
+		static PointRings^ FromFace(SUFaceRef face)
+		{
+			size_t count = 0;
+			SUFaceGetNumOpenings(face, &count);
 
-		System::Collections::Generic::List<Corner^>^ Corners;
+			std::vector<SUOpeningRef> openings(count);
+			if (count > 0)
+				SUFaceGetOpenings(face, count, &openings[0], &count);
 
+			return ToRings(openings, count);
+		}
 
-		Loop(System::Collections::Generic::List<Corner^>^ corners)
+		/// <summary>
+		/// Openings a definition cuts into the face it is glued to, in definition coordinates
+		/// </summary>
+		static PointRings^ FromDefinition(SUComponentDefinitionRef comp)
 		{
-			this->Corners = corners;
+			size_t count = 0;
+			SUComponentDefinitionGetNumOpenings(comp, &count);
 
-		};
+			std::vector<SUOpeningRef> openings(count);
+			if (count > 0)
+				SUComponentDefinitionGetOpenings(comp, count, &openings[0], &count);
 
-		Loop(){};
-	internal:
-		static Loop^ FromSU(SULoopRef loop)
+			return ToRings(openings, count);
+		}
+
+		/// <summary>
+		/// Copies and releases openings
+		/// </summary>
+		static PointRings^ ToRings(std::vector<SUOpeningRef>& openings, size_t count)
 		{
-			System::Collections::Generic::List<Corner^>^ corners = gcnew System::Collections::Generic::List<Corner^>();
+			std::vector<int> offsets(1, 0);
+			std::vector<double> points;
+			std::vector<SUPoint3D> buffer;
 
-			size_t edgeCount = 0;
-			SULoop(opening, &edgeCount);
-			if (edgeCount > 0)
+			for (size_t i = 0; i < count; i++)
 			{
-				std::vector<SUEdgeRef> edges(edgeCount);
-				SUFaceGetEdges(face, edgeCount, &edges[0], &edgeCount);
+				size_t pointCount = 0;
+				SUOpeningGetNumPoints(openings[i], &pointCount);
+				buffer.resize(pointCount);
+				if (pointCount > 0)
+					SUOpeningGetPoints(openings[i], pointCount, &buffer[0], &pointCount);
 
-				for (size_t j = 0; j < edgeCount; j++)
+				for (size_t k = 0; k < pointCount; k++)
 				{
-					corners->Add(Corner::FromSU(edges[j]));
+					points.push_back(buffer[k].x * 0.0254);
+					points.push_back(buffer[k].y * 0.0254);
+					points.push_back(buffer[k].z * 0.0254);
 				}
-			}
+				offsets.push_back((int)(points.size() / 3));
 
-
-			size_t openingsCount = 0;
-			SUFaceGetNumOpenings(face, &openingsCount);
-			if (openingsCount > 0)
-			{
-				std::vector<SUOpeningRef> openings(openingsCount);
-				SUFaceGetOpenings(face, openingsCount, &openings[0], &openingsCount);
-
-				for (size_t j = 0; j < openingsCount; j++)
-				{
-					corners->Add(Corner::FromSU(openings[j]));
-				}
+				SUOpeningRelease(&openings[i]);
 			}
 
-			Surface^ v = gcnew Surface(corners);
-
-			return v;
-		};
-
+			return gcnew PointRings(Utilities::ToArray(offsets), Utilities::ToArray(points));
+		}
 	};
 
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,142 @@
+/*
+
+SketchUpNET - a C++ Wrapper for the Trimble(R) SketchUp(R) C API
+Copyright(C) 2015, Autor: Maximilian Thumfart
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <SketchUpAPI/slapi.h>
+#include <SketchUpAPI/geometry.h>
+#include <SketchUpAPI/model/face.h>
+#include <SketchUpAPI/model/loop.h>
+#include <SketchUpAPI/model/vertex.h>
+#include <msclr/marshal.h>
+#include <vector>
+#include "vertex.h"
+#include "utilities.h"
+
+using namespace System;
+using namespace System::Collections;
+using namespace System::Collections::Generic;
+
+namespace SketchUpNET
+{
+	/// <summary>
+	/// Closed point rings stored in flat buffers.
+	/// Ring i consists of the points Offsets[i] to Offsets[i + 1] - 1.
+	/// </summary>
+	public ref class PointRings
+	{
+	public:
+		/// <summary>
+		/// Index of the first point of each ring, followed by the total point count
+		/// </summary>
+		array<int>^ Offsets;
+
+		/// <summary>
+		/// Ring points in meters as x,y,z triplets
+		/// </summary>
+		array<double>^ Points;
+
+		property int Count
+		{
+			int get() { return (Offsets == nullptr || Offsets->Length == 0) ? 0 : Offsets->Length - 1; }
+		}
+
+		PointRings(array<int>^ offsets, array<double>^ points)
+		{
+			this->Offsets = offsets;
+			this->Points = points;
+		};
+
+		PointRings(){};
+
+		/// <summary>
+		/// Number of points of a ring
+		/// </summary>
+		/// <param name="ring">Ring index</param>
+		int GetPointCount(int ring)
+		{
+			return Offsets[ring + 1] - Offsets[ring];
+		}
+
+		/// <summary>
+		/// Returns the points of a ring as vertices
+		/// </summary>
+		/// <param name="ring">Ring index</param>
+		List<Vertex^>^ GetRing(int ring)
+		{
+			List<Vertex^>^ vertices = gcnew List<Vertex^>(GetPointCount(ring));
+			for (int i = Offsets[ring]; i < Offsets[ring + 1]; i++)
+				vertices->Add(gcnew Vertex(Points[3 * i], Points[3 * i + 1], Points[3 * i + 2]));
+			return vertices;
+		}
+
+	internal:
+		static void AppendLoop(SULoopRef loop, std::vector<int>& offsets, std::vector<double>& points)
+		{
+			size_t count = 0;
+			SULoopGetNumVertices(loop, &count);
+			if (count > 0)
+			{
+				std::vector<SUVertexRef> vertices(count);
+				SULoopGetVertices(loop, count, &vertices[0], &count);
+
+				for (size_t i = 0; i < count; i++)
+				{
+					SUPoint3D pt = SU_INVALID;
+					SUVertexGetPosition(vertices[i], &pt);
+					points.push_back(pt.x * 0.0254);
+					points.push_back(pt.y * 0.0254);
+					points.push_back(pt.z * 0.0254);
+				}
+			}
+
+			offsets.push_back((int)(points.size() / 3));
+		}
+
+		/// <summary>
+		/// Reads the outer loop followed by all inner loops of a face
+		/// </summary>
+		static PointRings^ FromFace(SUFaceRef face)
+		{
+			std::vector<int> offsets(1, 0);
+			std::vector<double> points;
+
+			SULoopRef outer = SU_INVALID;
+			SUFaceGetOuterLoop(face, &outer);
+			AppendLoop(outer, offsets, points);
+
+			size_t innerCount = 0;
+			SUFaceGetNumInnerLoops(face, &innerCount);
+			if (innerCount > 0)
+			{
+				std::vector<SULoopRef> loops(innerCount);
+				SUFaceGetInnerLoops(face, innerCount, &loops[0], &innerCount);
+
+				for (size_t i = 0; i < innerCount; i++)
+					AppendLoop(loops[i], offsets, points);
+			}
+
+			return gcnew PointRings(Utilities::ToArray(offsets), Utilities::ToArray(points));
+		}
+	};
+
+
+}
@@ -0,0 +1,346 @@
+/*
+
+SketchUpNET - a C++ Wrapper for the Trimble(R) SketchUp(R) C API
+Copyright(C) 2015, Autor: Maximilian Thumfart
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <vector>
+#include <cmath>
+#include <climits>
+#include "utilities.h"
+#include "Transform.h"
+#include "MeshBatch.h"
+#include "Component.h"
+
+using namespace System;
+using namespace System::Collections;
+using namespace System::Collections::Generic;
+
+namespace SketchUpNET
+{
+	struct SampleMesh
+	{
+		std::vector<double> Positions;
+		std::vector<int> Indices;
+		std::vector<int> FaceIds;
+	};
+
+	/// <summary>
+	/// A mesh placed by a transformation and the range of samples it owns
+	/// </summary>
+	struct SampleJob
+	{
+		const SampleMesh* Mesh;
+		double Transform[16];
+		bool Flip;
+		double Area;
+		long long Offset;
+		long long Count;
+	};
+
+	/// <summary>
+	/// Area weighted stratified sampling of triangles. Every triangle draws from its own
+	/// random sequence seeded by seed, job and triangle, so results don't depend on threading.
+	/// </summary>
+	struct SampleKernel
+	{
+		enum Mode { MeasureArea = 0, CountSamples = 1, Generate = 2 };
+
+		SampleJob* Jobs;
+		Mode Pass;
+		double Density;
+		unsigned long long Seed;
+		float* Positions;
+		float* Normals;
+		int* FaceIds;
+
+		void operator()(int index) const
+		{
+			SampleJob& job = Jobs[index];
+			const SampleMesh& mesh = *job.Mesh;
+			int triangles = (int)(mesh.Indices.size() / 3);
+
+			if (Pass == MeasureArea) job.Area = 0;
+			if (Pass == CountSamples) job.Count = 0;
+			long long next = job.Offset;
+
+			for (int t = 0; t < triangles; t++)
+			{
+				double p[3][3];
+				for (int k = 0; k < 3; k++)
+					TransformMath::TransformPoint(job.Transform, &mesh.Positions[3 * mesh.Indices[3 * t + k]], p[k]);
+
+				double u[3], v[3], n[3];
+				for (int k = 0; k < 3; k++)
+				{
+					u[k] = p[1][k] - p[0][k];
+					v[k] = p[2][k] - p[0][k];
+				}
+				n[0] = u[1] * v[2] - u[2] * v[1];
+				n[1] = u[2] * v[0] - u[0] * v[2];
+				n[2] = u[0] * v[1] - u[1] * v[0];
+				double length = sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+				double area = 0.5 * length;
+
+				if (Pass == MeasureArea)
+				{
+					job.Area += area;
+					continue;
+				}
+
+				unsigned long long state = Mix(Mix(Seed + (unsigned long long)index) + (unsigned long long)t);
+				int count = (int)floor(area * Density + Uniform(state));
+				if (Pass == CountSamples)
+				{
+					job.Count += count;
+					continue;
+				}
+				if (count == 0) continue;
+
+				// Mirrored placements reverse the winding of the transformed triangle
+				double scale = (job.Flip ? -1.0 : 1.0) / length;
+				int faceId = mesh.FaceIds.empty() ? t : mesh.FaceIds[t];
+
+				// Jittered grid over the unit square for the largest square number of samples, the rest at random
+				int cells = (int)floor(sqrt((double)count));
+				for (int s = 0; s < count; s++)
+				{
+					double a = Uniform(state);
+					double b = Uniform(state);
+					if (s < cells * cells)
+					{
+						a = ((s % cells) + a) / cells;
+						b = ((s / cells) + b) / cells;
+					}
+
+					// Square root parametrization keeps strata equal in area on the triangle
+					double root = sqrt(a);
+					double w1 = root * (1.0 - b);
+					double w2 = root * b;
+
+					for (int k = 0; k < 3; k++)
+					{
+						Positions[3 * next + k] = (float)(p[0][k] + w1 * u[k] + w2 * v[k]);
+						Normals[3 * next + k] = (float)(n[k] * scale);
+					}
+					FaceIds[next] = faceId;
+					next++;
+				}
+			}
+		}
+
+		static unsigned long long Mix(unsigned long long z)
+		{
+			z += 0x9E3779B97F4A7C15ULL;
+			z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+			z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+			return z ^ (z >> 31);
+		}
+
+		static double Uniform(unsigned long long& state)
+		{
+			state = Mix(state);
+			return (state >> 11) * (1.0 / 9007199254740992.0);
+		}
+	};
+
+	/// <summary>
+	/// Points sampled uniformly over triangulated geometry, stored in flat buffers.
+	/// Positions and normals are single precision to keep a hundred million samples within array limits.
+	/// </summary>
+	public ref class PointSamples
+	{
+	public:
+		/// <summary>
+		/// Sample positions in meters as x,y,z triplets
+		/// </summary>
+		array<float>^ Positions;
+
+		/// <summary>
+		/// Unit face normals as x,y,z triplets
+		/// </summary>
+		array<float>^ Normals;
+
+		/// <summary>
+		/// Source face of each sample, the batch's FaceIds entry or the triangle index.
+		/// For model batches it indexes the batch's FacePersistentIds.
+		/// </summary>
+		array<int>^ FaceIds;
+
+		/// <summary>
+		/// Samples of source i are stored from Offsets[i] to Offsets[i + 1]
+		/// </summary>
+		array<int>^ Offsets;
+
+		property int Count
+		{
+			int get() { return (FaceIds == nullptr) ? 0 : FaceIds->Length; }
+		}
+
+		PointSamples(array<float>^ positions, array<float>^ normals, array<int>^ faceIds, array<int>^ offsets)
+		{
+			this->Positions = positions;
+			this->Normals = normals;
+			this->FaceIds = faceIds;
+			this->Offsets = offsets;
+		};
+
+		PointSamples() {};
+
+		/// <summary>
+		/// Samples batches with a given density, each batch placed by the transformation at the same index
+		/// </summary>
+		/// <param name="batches">Batches to sample, e.g. SketchUp.MeshBatches</param>
+		/// <param name="transformations">Transformation per batch, may be null</param>
+		/// <param name="density">Samples per square meter</param>
+		/// <param name="seed">Seed, equal inputs and seeds give equal samples</param>
+		/// <exception cref="System::ArgumentOutOfRangeException">More than about 700 million samples would be generated</exception>
+		static PointSamples^ Sample(List<MeshBatch^>^ batches, List<Transform^>^ transformations, double density, int seed)
+		{
+			return Run(batches, transformations, density, -1, seed);
+		}
+
+		/// <summary>
+		/// Samples batches with about a given number of samples in total
+		/// </summary>
+		/// <param name="batches">Batches to sample, e.g. SketchUp.MeshBatches</param>
+		/// <param name="transformations">Transformation per batch, may be null</param>
+		/// <param name="count">Number of samples to aim for</param>
+		/// <param name="seed">Seed, equal inputs and seeds give equal samples</param>
+		/// <exception cref="System::ArgumentOutOfRangeException">More than about 700 million samples would be generated</exception>
+		static PointSamples^ SampleCount(List<MeshBatch^>^ batches, List<Transform^>^ transformations, int count, int seed)
+		{
+			return Run(batches, transformations, 0, count, seed);
+		}
+
+		/// <summary>
+		/// Samples component instances in world space, Offsets follow the order of instances
+		/// </summary>
+		/// <param name="instances">Instances of components loaded including meshes</param>
+		/// <param name="density">Samples per square meter</param>
+		/// <param name="seed">Seed, equal inputs and seeds give equal samples</param>
+		/// <exception cref="System::ArgumentOutOfRangeException">More than about 700 million samples would be generated</exception>
+		static PointSamples^ SampleInstances(List<Instance^>^ instances, double density, int seed)
+		{
+			List<MeshBatch^>^ batches = gcnew List<MeshBatch^>();
+			List<Transform^>^ transformations = gcnew List<Transform^>();
+
+			for each (Instance^ instance in instances)
+			{
+				Component^ parent = dynamic_cast<Component^>(instance->Parent);
+				batches->Add(parent == nullptr ? nullptr : parent->MergedMesh);
+				transformations->Add(instance->Transformation);
+			}
+
+			return Run(batches, transformations, density, -1, seed);
+		}
+
+	internal:
+		static PointSamples^ Run(List<MeshBatch^>^ batches, List<Transform^>^ transformations, double density, long long target, int seed)
+		{
+			// Native copies shared by all placements of the same batch
+			std::vector<SampleMesh> meshes(batches->Count);
+			std::vector<SampleJob> jobs(batches->Count);
+			Dictionary<MeshBatch^, int>^ meshIndex = gcnew Dictionary<MeshBatch^, int>();
+			SampleMesh empty;
+			int meshCount = 0;
+
+			for (int i = 0; i < batches->Count; i++)
+			{
+				MeshBatch^ batch = batches[i];
+				SampleJob& job = jobs[i];
+				job.Mesh = &empty;
+				job.Area = 0;
+				job.Offset = 0;
+				job.Count = 0;
+				TransformMath::Identity(job.Transform);
+				if (transformations != nullptr && i < transformations->Count && transformations[i] != nullptr)
+					transformations[i]->CopyTo(job.Transform);
+				job.Flip = TransformMath::Determinant(job.Transform) < 0;
+
+				if (batch == nullptr || batch->TriangleCount == 0) continue;
+				if (!meshIndex->ContainsKey(batch))
+				{
+					SampleMesh& mesh = meshes[meshCount];
+					Utilities::FromArray(batch->Positions, mesh.Positions);
+					Utilities::FromArray(batch->Indices, mesh.Indices);
+					if (batch->FaceIds != nullptr && batch->FaceIds->Length == batch->TriangleCount)
+						Utilities::FromArray(batch->FaceIds, mesh.FaceIds);
+					meshIndex->Add(batch, meshCount++);
+				}
+				job.Mesh = &meshes[meshIndex[batch]];
+			}
+
+			SampleKernel kernel;
+			kernel.Jobs = jobs.empty() ? NULL : &jobs[0];
+			kernel.Density = density;
+			kernel.Seed = (unsigned long long)(unsigned int)seed;
+			kernel.Positions = NULL;
+			kernel.Normals = NULL;
+			kernel.FaceIds = NULL;
+
+			if (target >= 0)
+			{
+				kernel.Pass = SampleKernel::MeasureArea;
+				Utilities::ParallelFor((int)jobs.size(), kernel);
+
+				double area = 0;
+				for (size_t i = 0; i < jobs.size(); i++)
+					area += jobs[i].Area;
+				kernel.Density = (area > 0) ? target / area : 0;
+			}
+
+			kernel.Pass = SampleKernel::CountSamples;
+			Utilities::ParallelFor((int)jobs.size(), kernel);
+
+			array<int>^ offsets = gcnew array<int>(batches->Count + 1);
+			long long total = 0;
+			for (size_t i = 0; i < jobs.size(); i++)
+			{
+				offsets[(int)i] = (int)total;
+				jobs[i].Offset = total;
+				total += jobs[i].Count;
+				if (3 * total > INT_MAX)
+					throw gcnew System::ArgumentOutOfRangeException((target >= 0) ? "count" : "density", "Too many samples for a single PointSamples");
+			}
+			offsets[batches->Count] = (int)total;
+
+			array<float>^ positions = gcnew array<float>((int)(3 * total));
+			array<float>^ normals = gcnew array<float>((int)(3 * total));
+			array<int>^ faceIds = gcnew array<int>((int)total);
+
+			if (total > 0)
+			{
+				pin_ptr<float> pPositions = &positions[0];
+				pin_ptr<float> pNormals = &normals[0];
+				pin_ptr<int> pFaceIds = &faceIds[0];
+				kernel.Positions = pPositions;
+				kernel.Normals = pNormals;
+				kernel.FaceIds = pFaceIds;
+				kernel.Pass = SampleKernel::Generate;
+				Utilities::ParallelFor((int)jobs.size(), kernel);
+			}
+
+			return gcnew PointSamples(positions, normals, faceIds, offsets);
+		}
+	};
+
+
+}
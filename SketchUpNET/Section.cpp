@@ -0,0 +1,427 @@
+/*
+
+SketchUpNET - a C++ Wrapper for the Trimble(R) SketchUp(R) C API
+Copyright(C) 2015, Autor: Maximilian Thumfart
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <vector>
+#include <map>
+#include <cmath>
+#include <algorithm>
+#include "utilities.h"
+#include "MeshBatch.h"
+
+using namespace System;
+using namespace System::Collections;
+using namespace System::Collections::Generic;
+
+namespace SketchUpNET
+{
+	struct SliceMesh
+	{
+		std::vector<double> Positions;
+		std::vector<int> Indices;
+	};
+
+	struct SliceContour
+	{
+		int Mesh;
+		bool IsClosed;
+		std::vector<double> Points;
+	};
+
+	/// <summary>
+	/// 1D bucket index of triangle extents along one plane normal
+	/// </summary>
+	class SliceIndex
+	{
+	public:
+		double Normal[3];
+
+		void Build(const std::vector<SliceMesh>& meshes)
+		{
+			std::vector<double> mins, maxs;
+			std::vector<std::pair<int, int> > triangles;
+			low = 0;
+			double high = 0;
+
+			for (size_t m = 0; m < meshes.size(); m++)
+			{
+				const SliceMesh& mesh = meshes[m];
+				for (size_t t = 0; t + 2 < mesh.Indices.size(); t = t + 3)
+				{
+					double min = 0, max = 0;
+					for (int k = 0; k < 3; k++)
+					{
+						const double* p = &mesh.Positions[3 * mesh.Indices[t + k]];
+						double value = Normal[0] * p[0] + Normal[1] * p[1] + Normal[2] * p[2];
+						if (k == 0 || value < min) min = value;
+						if (k == 0 || value > max) max = value;
+					}
+					if (triangles.empty() || min < low) low = min;
+					if (triangles.empty() || max > high) high = max;
+					mins.push_back(min);
+					maxs.push_back(max);
+					triangles.push_back(std::make_pair((int)m, (int)(t / 3)));
+				}
+			}
+
+			int count = (std::max)(1, (int)sqrt((double)triangles.size()));
+			size = (high > low) ? (high - low) / count : 1.0;
+			buckets.assign(count, std::vector<std::pair<int, int> >());
+
+			for (size_t i = 0; i < triangles.size(); i++)
+			{
+				int first = Bucket(mins[i]);
+				int last = Bucket(maxs[i]);
+				for (int b = first; b <= last; b++)
+					buckets[b].push_back(triangles[i]);
+			}
+		}
+
+		/// <summary>
+		/// Triangles which may touch the plane at offset along the normal, as mesh and triangle index pairs
+		/// </summary>
+		const std::vector<std::pair<int, int> >& Query(double offset) const
+		{
+			return buckets[Bucket(offset)];
+		}
+
+	private:
+		double low;
+		double size;
+		std::vector<std::vector<std::pair<int, int> > > buckets;
+
+		int Bucket(double value) const
+		{
+			int bucket = (int)floor((value - low) / size);
+			return (std::min)((std::max)(bucket, 0), (int)buckets.size() - 1);
+		}
+	};
+
+	class Slicer;
+
+	struct SliceKernel
+	{
+		Slicer* Owner;
+
+		void operator()(int plane) const;
+	};
+
+	/// <summary>
+	/// Intersects triangle meshes with planes and stitches the segments into polylines per mesh
+	/// </summary>
+	class Slicer
+	{
+	public:
+		std::vector<SliceMesh> Meshes;
+
+		/// <summary>
+		/// Planes as a,b,c,d with a*x + b*y + c*z + d = 0
+		/// </summary>
+		std::vector<double> Planes;
+
+		/// <summary>
+		/// Contours per plane
+		/// </summary>
+		std::vector<std::vector<SliceContour> > Contours;
+
+		void Run()
+		{
+			int planeCount = (int)(Planes.size() / 4);
+			Contours.assign(planeCount, std::vector<SliceContour>());
+			planeIndex.assign(planeCount, -1);
+			indexes.clear();
+
+			// Planes sharing a normal share one index, e.g. all levels of a building
+			for (int p = 0; p < planeCount; p++)
+			{
+				double* plane = &Planes[4 * p];
+				double length = sqrt(plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2]);
+				if (length == 0) continue;
+				for (int k = 0; k < 4; k++) plane[k] /= length;
+
+				for (size_t i = 0; i < indexes.size() && planeIndex[p] < 0; i++)
+					if (indexes[i].Normal[0] == plane[0] && indexes[i].Normal[1] == plane[1] && indexes[i].Normal[2] == plane[2])
+						planeIndex[p] = (int)i;
+
+				if (planeIndex[p] < 0)
+				{
+					indexes.push_back(SliceIndex());
+					for (int k = 0; k < 3; k++) indexes.back().Normal[k] = plane[k];
+					indexes.back().Build(Meshes);
+					planeIndex[p] = (int)indexes.size() - 1;
+				}
+			}
+
+			SliceKernel kernel;
+			kernel.Owner = this;
+			Utilities::ParallelFor(planeCount, kernel);
+		}
+
+		void SlicePlane(int p)
+		{
+			if (planeIndex[p] < 0) return;
+
+			const double* plane = &Planes[4 * p];
+			const std::vector<std::pair<int, int> >& candidates = indexes[planeIndex[p]].Query(-plane[3]);
+
+			std::map<int, std::vector<double> > segments;
+			for (size_t i = 0; i < candidates.size(); i++)
+			{
+				const SliceMesh& mesh = Meshes[candidates[i].first];
+				const int* triangle = &mesh.Indices[3 * candidates[i].second];
+
+				const double* points[3];
+				double distances[3];
+				for (int k = 0; k < 3; k++)
+				{
+					points[k] = &mesh.Positions[3 * triangle[k]];
+					distances[k] = plane[0] * points[k][0] + plane[1] * points[k][1] + plane[2] * points[k][2] + plane[3];
+				}
+
+				// Points on the plane count as above it, so coplanar and touching triangles add no segments
+				double segment[6];
+				int found = 0;
+				for (int k = 0; k < 3 && found < 2; k++)
+				{
+					int j = (k + 1) % 3;
+					if ((distances[k] >= 0) == (distances[j] >= 0)) continue;
+					Intersect(points[k], distances[k], points[j], distances[j], &segment[3 * found]);
+					found++;
+				}
+
+				if (found < 2 || (segment[0] == segment[3] && segment[1] == segment[4] && segment[2] == segment[5])) continue;
+
+				std::vector<double>& target = segments[candidates[i].first];
+				target.insert(target.end(), segment, segment + 6);
+			}
+
+			for (std::map<int, std::vector<double> >::const_iterator it = segments.begin(); it != segments.end(); ++it)
+				Stitch(it->first, it->second, Contours[p]);
+		}
+
+	private:
+		std::vector<SliceIndex> indexes;
+		std::vector<int> planeIndex;
+
+		struct Point
+		{
+			double X, Y, Z;
+
+			bool operator<(const Point& other) const
+			{
+				if (X != other.X) return X < other.X;
+				if (Y != other.Y) return Y < other.Y;
+				return Z < other.Z;
+			}
+		};
+
+		// Computed from the lexicographically smaller end point, so both faces sharing an edge get identical points
+		static void Intersect(const double* a, double da, const double* b, double db, double* out)
+		{
+			if (da == 0) { for (int k = 0; k < 3; k++) out[k] = a[k]; return; }
+			if (db == 0) { for (int k = 0; k < 3; k++) out[k] = b[k]; return; }
+
+			bool swap = (b[0] < a[0]) || (b[0] == a[0] && (b[1] < a[1] || (b[1] == a[1] && b[2] < a[2])));
+			if (swap)
+			{
+				std::swap(a, b);
+				std::swap(da, db);
+			}
+
+			double t = da / (da - db);
+			for (int k = 0; k < 3; k++)
+				out[k] = a[k] + (b[k] - a[k]) * t;
+		}
+
+		static void Stitch(int mesh, const std::vector<double>& segments, std::vector<SliceContour>& contours)
+		{
+			std::map<Point, int> ids;
+			std::vector<Point> points;
+			std::vector<int> ends(segments.size() / 3);
+
+			for (size_t i = 0; i < ends.size(); i++)
+			{
+				Point point = { segments[3 * i], segments[3 * i + 1], segments[3 * i + 2] };
+				std::map<Point, int>::iterator it = ids.find(point);
+				if (it == ids.end())
+				{
+					it = ids.insert(std::make_pair(point, (int)points.size())).first;
+					points.push_back(point);
+				}
+				ends[i] = it->second;
+			}
+
+			std::vector<std::vector<int> > links(points.size());
+			for (size_t s = 0; s < ends.size() / 2; s++)
+			{
+				links[ends[2 * s]].push_back((int)s);
+				links[ends[2 * s + 1]].push_back((int)s);
+			}
+
+			// Walk open chains from their odd ends first, everything left is closed
+			std::vector<bool> used(ends.size() / 2, false);
+			for (int pass = 0; pass < 2; pass++)
+			{
+				for (size_t start = 0; start < points.size(); start++)
+				{
+					if (pass == 0 && links[start].size() % 2 == 0) continue;
+
+					for (size_t l = 0; l < links[start].size(); l++)
+					{
+						if (used[links[start][l]]) continue;
+
+						SliceContour contour;
+						contour.Mesh = mesh;
+						int current = (int)start;
+						int segment = links[start][l];
+						AppendPoint(points[current], contour.Points);
+
+						while (segment >= 0)
+						{
+							used[segment] = true;
+							current = (ends[2 * segment] == current) ? ends[2 * segment + 1] : ends[2 * segment];
+							if (current == (int)start) break;
+							AppendPoint(points[current], contour.Points);
+
+							segment = -1;
+							for (size_t n = 0; n < links[current].size(); n++)
+								if (!used[links[current][n]]) { segment = links[current][n]; break; }
+						}
+
+						contour.IsClosed = current == (int)start;
+						contours.push_back(contour);
+					}
+				}
+			}
+		}
+
+		static void AppendPoint(const Point& point, std::vector<double>& points)
+		{
+			points.push_back(point.X);
+			points.push_back(point.Y);
+			points.push_back(point.Z);
+		}
+	};
+
+	inline void SliceKernel::operator()(int plane) const
+	{
+		Owner->SlicePlane(plane);
+	}
+
+	/// <summary>
+	/// Polyline where a plane cuts the faces of one layer and material
+	/// </summary>
+	public ref class SectionContour
+	{
+	public:
+		/// <summary>
+		/// Index of the cutting plane
+		/// </summary>
+		int Plane;
+
+		/// <summary>
+		/// Layer of the cut faces
+		/// </summary>
+		System::String^ Layer;
+
+		/// <summary>
+		/// Material of the cut faces
+		/// </summary>
+		SketchUpNET::Material^ Material;
+
+		/// <summary>
+		/// Polyline points in meters as x,y,z triplets, the last point is not repeated for closed contours
+		/// </summary>
+		array<double>^ Points;
+
+		/// <summary>
+		/// Polyline is closed
+		/// </summary>
+		bool IsClosed;
+
+		SectionContour(int plane, System::String^ layer, SketchUpNET::Material^ material, array<double>^ points, bool isClosed)
+		{
+			this->Plane = plane;
+			this->Layer = layer;
+			this->Material = material;
+			this->Points = points;
+			this->IsClosed = isClosed;
+		};
+
+		SectionContour(){};
+
+		/// <summary>
+		/// Horizontal planes from an elevation to another at a fixed step, in meters
+		/// </summary>
+		static array<double>^ HorizontalPlanes(double from, double to, double step)
+		{
+			List<double>^ planes = gcnew List<double>();
+			if (step > 0)
+			{
+				int count = (int)floor((to - from) / step + 1e-9) + 1;
+				for (int i = 0; i < count; i++)
+				{
+					planes->Add(0);
+					planes->Add(0);
+					planes->Add(1);
+					planes->Add(-(from + i * step));
+				}
+			}
+			return planes->ToArray();
+		}
+
+		/// <summary>
+		/// Cuts mesh batches with planes, all planes in parallel.
+		/// Contours are stitched per batch, load batches by LayerAndMaterial to keep them apart.
+		/// </summary>
+		/// <param name="batches">Mesh batches, e.g. of LoadMeshBatches</param>
+		/// <param name="planes">Planes as a,b,c,d quadruples with a*x + b*y + c*z + d = 0, in meters</param>
+		static List<SectionContour^>^ Slice(List<MeshBatch^>^ batches, array<double>^ planes)
+		{
+			Slicer slicer;
+			slicer.Meshes.resize(batches->Count);
+			for (int i = 0; i < batches->Count; i++)
+			{
+				Utilities::FromArray(batches[i]->Positions, slicer.Meshes[i].Positions);
+				Utilities::FromArray(batches[i]->Indices, slicer.Meshes[i].Indices);
+			}
+			Utilities::FromArray(planes, slicer.Planes);
+
+			slicer.Run();
+
+			List<SectionContour^>^ contours = gcnew List<SectionContour^>();
+			for (size_t p = 0; p < slicer.Contours.size(); p++)
+			{
+				for (size_t c = 0; c < slicer.Contours[p].size(); c++)
+				{
+					const SliceContour& contour = slicer.Contours[p][c];
+					MeshBatch^ batch = batches[contour.Mesh];
+					contours->Add(gcnew SectionContour((int)p, batch->Layer, batch->Material, Utilities::ToArray(contour.Points), contour.IsClosed));
+				}
+			}
+
+			return contours;
+		}
+	};
+
+
+}
@@ -0,0 +1,490 @@
+/*
+
+SketchUpNET - a C++ Wrapper for the Trimble(R) SketchUp(R) C API
+Copyright(C) 2015, Autor: Maximilian Thumfart
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <vector>
+#include <map>
+#include <queue>
+#include <cmath>
+#include <algorithm>
+
+namespace SketchUpNET
+{
+	/// <summary>
+	/// Quadric error edge collapse simplifier (Garland and Heckbert) for flat triangle buffers.
+	/// Vertices are welded by position. Open borders, which include the borders between
+	/// material batches, borders between materials within a batch and texture coordinate
+	/// seams are locked. Collapses move a vertex onto a neighbour, so kept vertices keep their
+	/// normals and texture coordinates, and the moved corners take the attributes of the
+	/// neighbour on the same side of a normal seam.
+	/// </summary>
+	class MeshSimplifier
+	{
+	public:
+		std::vector<double> Positions;
+		std::vector<double> Normals;
+		std::vector<double> TexCoords;
+		std::vector<int> Indices;
+
+		/// <summary>
+		/// Material of each triangle, empty if all triangles share one material
+		/// </summary>
+		std::vector<int> MaterialIds;
+
+		/// <summary>
+		/// Source face of each triangle, passed through to OutFaceIds
+		/// </summary>
+		std::vector<int> FaceIds;
+
+		/// <summary>
+		/// Stop once no more than this many triangles are left
+		/// </summary>
+		int TargetTriangles;
+
+		/// <summary>
+		/// Largest allowed distance of the simplified surface to the original one, in meters
+		/// </summary>
+		double MaxError;
+
+		/// <summary>
+		/// Lock vertices on texture coordinate seams, only needed for textured materials
+		/// </summary>
+		bool LockSeams;
+
+		std::vector<double> OutPositions;
+		std::vector<double> OutNormals;
+		std::vector<double> OutTexCoords;
+		std::vector<int> OutIndices;
+		std::vector<int> OutMaterialIds;
+		std::vector<int> OutFaceIds;
+
+		MeshSimplifier() : TargetTriangles(0), MaxError(0), LockSeams(true) {}
+
+		void Run()
+		{
+			Weld();
+			BuildQuadrics();
+
+			std::priority_queue<Collapse, std::vector<Collapse>, std::greater<Collapse> > queue;
+			for (int v = 0; v < (int)vertexTriangles.size(); v++)
+				PushCollapses(v, queue);
+
+			int live = (int)std::count(removed.begin(), removed.end(), false);
+			double maxCost = MaxError * MaxError;
+			while (live > TargetTriangles && !queue.empty())
+			{
+				Collapse collapse = queue.top();
+				queue.pop();
+
+				if (collapse.Cost > maxCost) break;
+				if (collapse.FromVersion != versions[collapse.From] || collapse.ToVersion != versions[collapse.To]) continue;
+				if (!CanCollapse(collapse.From, collapse.To)) continue;
+
+				live -= Apply(collapse.From, collapse.To);
+				PushCollapses(collapse.To, queue);
+			}
+
+			Compact();
+		}
+
+	private:
+		struct Collapse
+		{
+			double Cost;
+			int From, To;
+			int FromVersion, ToVersion;
+
+			bool operator>(const Collapse& other) const { return Cost > other.Cost; }
+		};
+
+		struct Key
+		{
+			double X, Y, Z;
+
+			bool operator<(const Key& other) const
+			{
+				if (X != other.X) return X < other.X;
+				if (Y != other.Y) return Y < other.Y;
+				return Z < other.Z;
+			}
+		};
+
+		// Welded vertex of each triangle corner, corner attributes index the input vertices
+		std::vector<int> corners;
+		std::vector<int> attributes;
+		std::vector<bool> removed;
+		std::vector<double> points;
+		std::vector<bool> locked;
+		std::vector<int> versions;
+		std::vector<std::vector<int> > vertexTriangles;
+		std::vector<double> quadrics;
+
+		void Weld()
+		{
+			int vertexCount = (int)(Positions.size() / 3);
+			bool hasTexCoords = TexCoords.size() == 2 * (size_t)vertexCount;
+
+			std::map<Key, int> ids;
+			std::vector<int> welded(vertexCount);
+			for (int i = 0; i < vertexCount; i++)
+			{
+				Key key = { Positions[3 * i], Positions[3 * i + 1], Positions[3 * i + 2] };
+				std::map<Key, int>::iterator it = ids.find(key);
+				if (it == ids.end())
+				{
+					it = ids.insert(std::make_pair(key, (int)(points.size() / 3))).first;
+					points.insert(points.end(), &Positions[3 * i], &Positions[3 * i] + 3);
+				}
+				welded[i] = it->second;
+			}
+
+			int count = (int)(points.size() / 3);
+			locked.assign(count, false);
+			versions.assign(count, 0);
+			vertexTriangles.assign(count, std::vector<int>());
+
+			// Texture coordinate seams, a welded vertex with corners of different coordinates
+			std::vector<int> firstAttribute(count, -1);
+			for (size_t c = 0; c < Indices.size(); c++)
+			{
+				int attribute = Indices[c];
+				int vertex = welded[attribute];
+				corners.push_back(vertex);
+				attributes.push_back(attribute);
+
+				if (firstAttribute[vertex] < 0) firstAttribute[vertex] = attribute;
+				else if (LockSeams && hasTexCoords && (TexCoords[2 * attribute] != TexCoords[2 * firstAttribute[vertex]] || TexCoords[2 * attribute + 1] != TexCoords[2 * firstAttribute[vertex] + 1]))
+					locked[vertex] = true;
+			}
+
+			int triangleCount = (int)(corners.size() / 3);
+			removed.assign(triangleCount, false);
+
+			// Material boundaries, a welded vertex with triangles of different materials
+			if (MaterialIds.size() == (size_t)triangleCount)
+			{
+				std::vector<int> firstMaterial(count, -1);
+				for (int t = 0; t < triangleCount; t++)
+				{
+					for (int k = 0; k < 3; k++)
+					{
+						int vertex = corners[3 * t + k];
+						if (firstMaterial[vertex] < 0) firstMaterial[vertex] = MaterialIds[t];
+						else if (firstMaterial[vertex] != MaterialIds[t]) locked[vertex] = true;
+					}
+				}
+			}
+
+			// Open borders, edges used by a single triangle
+			std::map<std::pair<int, int>, int> edgeUses;
+			for (int t = 0; t < triangleCount; t++)
+			{
+				for (int k = 0; k < 3; k++)
+				{
+					int a = corners[3 * t + k];
+					int b = corners[3 * t + (k + 1) % 3];
+					edgeUses[std::make_pair((std::min)(a, b), (std::max)(a, b))]++;
+					vertexTriangles[a].push_back(t);
+				}
+				if (corners[3 * t] == corners[3 * t + 1] || corners[3 * t + 1] == corners[3 * t + 2] || corners[3 * t] == corners[3 * t + 2])
+					removed[t] = true;
+			}
+			for (std::map<std::pair<int, int>, int>::const_iterator it = edgeUses.begin(); it != edgeUses.end(); ++it)
+			{
+				if (it->second != 2)
+				{
+					locked[it->first.first] = true;
+					locked[it->first.second] = true;
+				}
+			}
+		}
+
+		void Normal(const double* a, const double* b, const double* c, double* n) const
+		{
+			double u[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+			double v[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+			n[0] = u[1] * v[2] - u[2] * v[1];
+			n[1] = u[2] * v[0] - u[0] * v[2];
+			n[2] = u[0] * v[1] - u[1] * v[0];
+		}
+
+		// Symmetric 4x4 quadric stored as 10 upper triangle values per vertex
+		void BuildQuadrics()
+		{
+			quadrics.assign(10 * (points.size() / 3), 0.0);
+			for (int t = 0; t < (int)removed.size(); t++)
+			{
+				if (removed[t]) continue;
+
+				const double* a = &points[3 * corners[3 * t]];
+				double n[3];
+				Normal(a, &points[3 * corners[3 * t + 1]], &points[3 * corners[3 * t + 2]], n);
+				double length = sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+				if (length == 0) continue;
+
+				// Unweighted, so errors are sums of squared distances to the original planes
+				for (int j = 0; j < 3; j++) n[j] /= length;
+				double plane[4] = { n[0], n[1], n[2], -(n[0] * a[0] + n[1] * a[1] + n[2] * a[2]) };
+
+				for (int k = 0; k < 3; k++)
+				{
+					double* q = &quadrics[10 * corners[3 * t + k]];
+					int index = 0;
+					for (int i = 0; i < 4; i++)
+						for (int j = i; j < 4; j++)
+							q[index++] += plane[i] * plane[j];
+				}
+			}
+		}
+
+		double Error(int a, int b, const double* p) const
+		{
+			const double* qa = &quadrics[10 * a];
+			const double* qb = &quadrics[10 * b];
+			double v[4] = { p[0], p[1], p[2], 1.0 };
+			double error = 0;
+			int index = 0;
+			for (int i = 0; i < 4; i++)
+				for (int j = i; j < 4; j++, index++)
+					error += (i == j ? 1.0 : 2.0) * (qa[index] + qb[index]) * v[i] * v[j];
+			return error;
+		}
+
+		void Neighbours(int vertex, std::vector<int>& result) const
+		{
+			result.clear();
+			for (size_t i = 0; i < vertexTriangles[vertex].size(); i++)
+			{
+				int t = vertexTriangles[vertex][i];
+				if (removed[t]) continue;
+				for (int k = 0; k < 3; k++)
+				{
+					int other = corners[3 * t + k];
+					if (other != vertex && std::find(result.begin(), result.end(), other) == result.end())
+						result.push_back(other);
+				}
+			}
+		}
+
+		template <typename Queue>
+		void PushCollapses(int vertex, Queue& queue) const
+		{
+			std::vector<int> neighbours;
+			Neighbours(vertex, neighbours);
+			for (size_t i = 0; i < neighbours.size(); i++)
+			{
+				int other = neighbours[i];
+				if (!locked[vertex]) queue.push(MakeCollapse(vertex, other));
+				if (!locked[other]) queue.push(MakeCollapse(other, vertex));
+			}
+		}
+
+		Collapse MakeCollapse(int from, int to) const
+		{
+			Collapse collapse;
+			collapse.Cost = (std::max)(0.0, Error(from, to, &points[3 * to]));
+			collapse.From = from;
+			collapse.To = to;
+			collapse.FromVersion = versions[from];
+			collapse.ToVersion = versions[to];
+			return collapse;
+		}
+
+		bool CanCollapse(int from, int to) const
+		{
+			// Link condition keeps the surface manifold: the edge's triangles are the only shared ones
+			std::vector<int> fromNeighbours, toNeighbours;
+			Neighbours(from, fromNeighbours);
+			Neighbours(to, toNeighbours);
+			int shared = 0;
+			for (size_t i = 0; i < fromNeighbours.size(); i++)
+				if (std::find(toNeighbours.begin(), toNeighbours.end(), fromNeighbours[i]) != toNeighbours.end()) shared++;
+
+			int edgeTriangles = 0;
+			for (size_t i = 0; i < vertexTriangles[from].size(); i++)
+			{
+				int t = vertexTriangles[from][i];
+				if (removed[t]) continue;
+
+				bool hasTo = corners[3 * t] == to || corners[3 * t + 1] == to || corners[3 * t + 2] == to;
+				if (hasTo)
+				{
+					edgeTriangles++;
+					continue;
+				}
+
+				// Reject collapses flipping or degenerating a remaining triangle
+				const double* p[3];
+				const double* q[3];
+				for (int k = 0; k < 3; k++)
+				{
+					p[k] = &points[3 * corners[3 * t + k]];
+					q[k] = (corners[3 * t + k] == from) ? &points[3 * to] : p[k];
+				}
+				double before[3], after[3];
+				Normal(p[0], p[1], p[2], before);
+				Normal(q[0], q[1], q[2], after);
+				double dot = before[0] * after[0] + before[1] * after[1] + before[2] * after[2];
+				double lengths = sqrt((before[0] * before[0] + before[1] * before[1] + before[2] * before[2]) * (after[0] * after[0] + after[1] * after[1] + after[2] * after[2]));
+				if (lengths == 0 || dot < 0.2 * lengths) return false;
+			}
+
+			if (edgeTriangles == 0 || shared != edgeTriangles) return false;
+
+			std::vector<int> targets;
+			return MatchWedges(from, to, targets);
+		}
+
+		bool SameAttributes(int a, int b) const
+		{
+			if (a == b) return true;
+
+			if (Normals.size() == Positions.size())
+			{
+				for (int k = 0; k < 3; k++)
+					if (fabs(Normals[3 * a + k] - Normals[3 * b + k]) > 1e-9) return false;
+			}
+
+			if (LockSeams && TexCoords.size() == 2 * (Positions.size() / 3))
+				return TexCoords[2 * a] == TexCoords[2 * b] && TexCoords[2 * a + 1] == TexCoords[2 * b + 1];
+			return true;
+		}
+
+		int CornerAttribute(int t, int vertex) const
+		{
+			for (int k = 0; k < 3; k++)
+				if (corners[3 * t + k] == vertex) return attributes[3 * t + k];
+			return -1;
+		}
+
+		// Picks the attribute of to for every remaining triangle of from, from the collapsing triangles
+		// whose corner of from has the same attributes, i.e. lies on the same side of a seam.
+		// Fails if a side has no collapsing triangle or its collapsing triangles disagree.
+		bool MatchWedges(int from, int to, std::vector<int>& targets) const
+		{
+			const std::vector<int>& triangles = vertexTriangles[from];
+			std::vector<int> fromSides, toSides;
+			for (size_t i = 0; i < triangles.size(); i++)
+			{
+				int t = triangles[i];
+				if (removed[t] || CornerAttribute(t, to) < 0) continue;
+				fromSides.push_back(CornerAttribute(t, from));
+				toSides.push_back(CornerAttribute(t, to));
+			}
+
+			targets.assign(triangles.size(), -1);
+			for (size_t i = 0; i < triangles.size(); i++)
+			{
+				int t = triangles[i];
+				if (removed[t] || CornerAttribute(t, to) >= 0) continue;
+
+				int fromAttribute = CornerAttribute(t, from);
+				for (size_t j = 0; j < fromSides.size(); j++)
+				{
+					if (!SameAttributes(fromAttribute, fromSides[j])) continue;
+					if (targets[i] < 0) targets[i] = toSides[j];
+					else if (!SameAttributes(targets[i], toSides[j])) return false;
+				}
+				if (targets[i] < 0) return false;
+			}
+			return true;
+		}
+
+		// Moves from onto to, returns the number of removed triangles
+		int Apply(int from, int to)
+		{
+			// Corner attributes of to on the side of from, per remaining triangle
+			std::vector<int> targets;
+			MatchWedges(from, to, targets);
+
+			int removedCount = 0;
+			for (size_t i = 0; i < vertexTriangles[from].size(); i++)
+			{
+				int t = vertexTriangles[from][i];
+				if (removed[t] || CornerAttribute(t, to) < 0) continue;
+				removed[t] = true;
+				removedCount++;
+			}
+
+			for (size_t i = 0; i < vertexTriangles[from].size(); i++)
+			{
+				int t = vertexTriangles[from][i];
+				if (removed[t]) continue;
+				for (int k = 0; k < 3; k++)
+				{
+					if (corners[3 * t + k] != from) continue;
+					corners[3 * t + k] = to;
+					if (targets[i] >= 0) attributes[3 * t + k] = targets[i];
+				}
+				vertexTriangles[to].push_back(t);
+			}
+
+			vertexTriangles[from].clear();
+			for (int i = 0; i < 10; i++)
+				quadrics[10 * to + i] += quadrics[10 * from + i];
+			versions[from]++;
+			versions[to]++;
+			return removedCount;
+		}
+
+		void Compact()
+		{
+			int vertexCount = (int)(Positions.size() / 3);
+			bool hasNormals = Normals.size() == Positions.size();
+			bool hasTexCoords = TexCoords.size() == 2 * (size_t)vertexCount;
+			bool hasMaterials = MaterialIds.size() == removed.size();
+			bool hasFaces = FaceIds.size() == removed.size();
+			std::vector<int> remap(vertexCount, -1);
+
+			for (size_t t = 0; t < removed.size(); t++)
+			{
+				if (removed[t]) continue;
+				for (int k = 0; k < 3; k++)
+				{
+					int attribute = attributes[3 * t + k];
+					if (remap[attribute] < 0)
+					{
+						remap[attribute] = (int)(OutPositions.size() / 3);
+						OutPositions.insert(OutPositions.end(), &Positions[3 * attribute], &Positions[3 * attribute] + 3);
+						if (hasNormals) OutNormals.insert(OutNormals.end(), &Normals[3 * attribute], &Normals[3 * attribute] + 3);
+						if (hasTexCoords) OutTexCoords.insert(OutTexCoords.end(), &TexCoords[2 * attribute], &TexCoords[2 * attribute] + 2);
+					}
+					OutIndices.push_back(remap[attribute]);
+				}
+				if (hasMaterials) OutMaterialIds.push_back(MaterialIds[t]);
+				if (hasFaces) OutFaceIds.push_back(FaceIds[t]);
+			}
+		}
+	};
+
+	struct SimplifyKernel
+	{
+		MeshSimplifier* Simplifiers;
+
+		void operator()(int index) const
+		{
+			Simplifiers[index].Run();
+		}
+	};
+
+
+}
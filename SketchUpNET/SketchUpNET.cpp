@@ -30,16 +30,27 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include <SketchUpAPI/model/face.h>
 #include <SketchUpAPI/model/edge.h>
 #include <SketchUpAPI/model/vertex.h>
+#include <SketchUpAPI/model/scene.h>
 #include <msclr/marshal.h>
 #include <vector>
 #include "Utilities.h"
 #include "Surface.h"
 #include "Edge.h"
 #include "Curve.h"
+#include "ArcTable.h"
+#include "Annotations.h"
+#include "Image.h"
 #include "Layer.h"
 #include "Group.h"
 #include "Instance.h"
 #include "Component.h"
+#include "MeshBatch.h"
+#include "LoadOptions.h"
+#include "LoadContext.h"
+#include "Section.h"
+#include "Attributes.h"
+#include "Camera.h"
+#include "ViewTable.h"
 
 using namespace System;
 using namespace System::Collections;
@@ -88,6 +99,11 @@ namespace SketchUpNET
 		/// </summary>
 		System::Collections::Generic::Dictionary<String^, Component^>^ Components;
 
+		/// <summary>
+		/// Containing Model Group Definitions, shared by all copies of a group (Group.Definition)
+		/// </summary>
+		System::Collections::Generic::Dictionary<String^, Component^>^ GroupDefinitions;
+
 		/// <summary>
 		/// Containing Model Material Definitions
 		/// </summary>
@@ -103,11 +119,62 @@ namespace SketchUpNET
 		/// </summary>
 		System::Collections::Generic::List<Curve^>^ Curves; 
 
+		/// <summary>
+		/// Containing Model Arcs and Circles, only available if the model has been loaded with ArcsAsTable
+		/// </summary>
+		ArcTable^ Arcs;
+
+		/// <summary>
+		/// Containing Model Guides, Polylines, Texts and Dimensions, only available if the model has been loaded with Annotations
+		/// </summary>
+		AnnotationTable^ Annotations;
+
+		/// <summary>
+		/// Containing Model Image entities, pixels can be read through a ModelSession
+		/// </summary>
+		System::Collections::Generic::List<Image^>^ Images;
+
 		/// <summary>
 		/// Containing Model Edges (Lines)
 		/// </summary>
 		System::Collections::Generic::List<Edge^>^ Edges;
 
+		/// <summary>
+		/// Containing merged world space Meshes, see LoadMeshBatches
+		/// </summary>
+		System::Collections::Generic::List<MeshBatch^>^ MeshBatches;
+
+		/// <summary>
+		/// Containing section contours, see LoadSections
+		/// </summary>
+		System::Collections::Generic::List<SectionContour^>^ Sections;
+
+		/// <summary>
+		/// Containing requested entity attributes, see LoadAttributes and LoadOptions.Attributes
+		/// </summary>
+		AttributeTable^ Attributes;
+
+		/// <summary>
+		/// Containing classifications and dynamic component attributes, one row per loaded instance (Instance.InfoRow),
+		/// see LoadOptions.Classifications and LoadOptions.DynamicAttributes
+		/// </summary>
+		AttributeTable^ InstanceInfo;
+
+		/// <summary>
+		/// Loaded entities by persistent id, only available if the model has been loaded with IndexPersistentIds
+		/// </summary>
+		System::Collections::Generic::Dictionary<Int64, Object^>^ PersistentIndex;
+
+		/// <summary>
+		/// Camera of the scene the model has been loaded with, see LoadOptions.Scene
+		/// </summary>
+		SketchUpNET::Camera^ Camera;
+
+		/// <summary>
+		/// Containing the cameras of all scenes, see LoadViews
+		/// </summary>
+		ViewTable^ Views;
+
 		/// <summary>
 		/// Version of the loaded file is more recent than the SketchUp API
 		/// </summary>
@@ -129,6 +196,28 @@ namespace SketchUpNET
 		/// <param name="filename">Path to .skp file</param>
 		/// <param name="includeMeshes">Load model including meshed geometries</param>
 		bool LoadModel(System::String^ filename, bool includeMeshes)
+		{
+			return LoadModel(filename, gcnew LoadOptions(includeMeshes));
+		}
+
+		/// <summary>
+		/// Loads a SketchUp Model from filepath using options controlling which data is read.
+		/// </summary>
+		/// <param name="filename">Path to .skp file</param>
+		/// <param name="options">Load options</param>
+		bool LoadModel(System::String^ filename, LoadOptions^ options)
+		{
+			return LoadModel(filename, options->Scene, options);
+		};
+
+		/// <summary>
+		/// Loads what a scene of a SketchUp Model shows and the scene's camera (Camera).
+		/// Returns false without changing this object if the model has no scene of this name.
+		/// </summary>
+		/// <param name="filename">Path to .skp file</param>
+		/// <param name="scene">Name of the scene, null loads the model as LoadModel(filename, options) does</param>
+		/// <param name="options">Load options, Scene is ignored in favor of scene</param>
+		bool LoadModel(System::String^ filename, System::String^ scene, LoadOptions^ options)
 		{
 			const char* path = Utilities::ToString(filename);
 
@@ -138,111 +227,295 @@ namespace SketchUpNET
 			SUModelRef model = SU_INVALID;
 			SUModelLoadStatus status;
 			SUModelCreateFromFileWithStatus(&model, path, &status);
-			
+			delete[] path;
 
-			if (status == SUModelLoadStatus_Success_MoreRecent)
-				MoreRecentFileVersion = true;
-			else
-				MoreRecentFileVersion = false;
+			SUEntitiesRef entities = SU_INVALID;
+			SUModelGetEntities(model, &entities);
 
+			// The scene is looked up before anything of a previous load is replaced
+			SUSceneRef sceneRef = SU_INVALID;
+			if (scene != nullptr)
+			{
+				const char* sceneName = Utilities::ToString(scene);
+				SUResult found = SUModelGetSceneWithName(model, sceneName, &sceneRef);
+				delete[] sceneName;
 
-			Layers = gcnew System::Collections::Generic::List<Layer^>();
-			Groups = gcnew System::Collections::Generic::List<Group^>();
-			Components = gcnew System::Collections::Generic::Dictionary<String^,Component^>();
-			Materials = gcnew System::Collections::Generic::Dictionary<String^, Material^>();
+				if (found != SU_ERROR_NONE || SUIsInvalid(sceneRef))
+				{
+					SUModelRelease(&model);
+					SUTerminate();
+					return false;
+				}
+			}
 
-			SUEntitiesRef entities = SU_INVALID;
-			SUModelGetEntities(model, &entities);
+			LoadContext^ context = gcnew LoadContext(options);
+			try
+			{
+				if (status == SUModelLoadStatus_Success_MoreRecent)
+					MoreRecentFileVersion = true;
+				else
+					MoreRecentFileVersion = false;
+
+
+				Groups = gcnew System::Collections::Generic::List<Group^>();
+				Components = gcnew System::Collections::Generic::Dictionary<String^,Component^>();
 
-			//Get All Materials
-			size_t matCount = 0;
-			SUModelGetNumMaterials(model, &matCount);
+				LoadMaterials(model);
+				LoadLayers(model);
 
-			if (matCount > 0) {
-				std::vector<SUMaterialRef> materials(matCount);
-				SUModelGetMaterials(model, matCount, &materials[0], &matCount);
+				Camera = nullptr;
+				context->Visibility = options->VisibleOnly ? gcnew VisibilityFilter() : nullptr;
 
-				for (size_t i = 0; i < matCount; i++) {
-					Material^ mat = Material::FromSU(materials[i]);
-					if (!Materials->ContainsKey(mat->Name))
-						Materials->Add(mat->Name, mat);
+				if (scene != nullptr)
+				{
+					SUCameraRef camera = SU_INVALID;
+					SUSceneGetCamera(sceneRef, &camera);
+					Camera = SketchUpNET::Camera::FromSU(camera);
+					context->Visibility = VisibilityFilter::FromScene(sceneRef, entities);
 				}
-			}
-			
-			//Get All Layers
-			size_t layerCount = 0;
-			SUModelGetNumLayers(model, &layerCount);
 
-			if (layerCount > 0) {
-				std::vector<SULayerRef> layers(layerCount);
-				SUModelGetLayers(model, layerCount, &layers[0], &layerCount);
+				context->InstanceInfo = (options->Classifications != nullptr || options->DynamicAttributes != nullptr) ? gcnew InstanceInfoCollector(options->Classifications, options->DynamicAttributes) : nullptr;
+				context->GroupDefinitions = gcnew HashSet<IntPtr>();
+				context->PendingGroupDefinitions = gcnew List<IntPtr>();
+
+				//Get All Groups	
+				size_t groupCount = 0;
+				SUEntitiesGetNumGroups(entities, &groupCount);
+
+				if (groupCount > 0) {
+					std::vector<SUGroupRef> groups(groupCount);
+					SUEntitiesGetGroups(entities, groupCount, &groups[0], &groupCount);
+
+					for (size_t i = 0; i < groupCount; i++) {
+						if (!context->IsVisible(SUGroupToDrawingElement(groups[i]))) continue;
+
+						Group^ group = Group::FromSU(groups[i], context, Materials);
+						Groups->Add(group);
+					}
 
-				for (size_t i = 0; i < layerCount; i++) {
-					Layer^ layer = Layer::FromSU(layers[i]);
-					Layers->Add(layer);
 				}
-			}
 
-			//Get All Groups	
-			size_t groupCount = 0;
-			SUEntitiesGetNumGroups(entities, &groupCount);
 
-			if (groupCount > 0) {
-				std::vector<SUGroupRef> groups(groupCount);
-				SUEntitiesGetGroups(entities, groupCount, &groups[0], &groupCount);
+				// Get all Components, or only the ones used by visible instances
+				size_t compCount = 0;
+				std::vector<SUComponentDefinitionRef> comps;
+				if (context->Visibility != nullptr)
+				{
+					CollectDefinitions(entities, context, gcnew HashSet<IntPtr>(), comps);
+					compCount = comps.size();
+				}
+				else
+				{
+					SUModelGetNumComponentDefinitions(model, &compCount);
+					comps.resize(compCount);
+					if (compCount > 0)
+						SUModelGetComponentDefinitions(model, compCount, &comps[0], &compCount);
+				}
 
-				for (size_t i = 0; i < groupCount; i++) {
-					Group^ group = Group::FromSU(groups[i], includeMeshes, Materials);
-					Groups->Add(group);
+				if (compCount > 0) {
+					for (size_t i = 0; i < compCount; i++) {
+						Component^ component = Component::FromSU(comps[i], context, Materials);
+						Components->Add(component->Guid, component);
+					}
 				}
 
-			}
+				Surfaces = Surface::GetEntitySurfaces(entities, context, Materials);
+				Curves = Curve::GetEntityCurves(entities, context);
+				Arcs = options->ArcsAsTable ? ArcTable::FromEntities(entities, context) : nullptr;
+				Images = Image::GetEntityImages(entities, context);
+				Annotations = (options->Annotations != AnnotationKinds::None) ? AnnotationTable::FromEntities(entities, context) : nullptr;
+				Edges = Edge::GetEntityEdges(entities, context);
+				Instances = Instance::GetEntityInstances(entities, context, Materials);
 
+				LoadGroupDefinitions(context);
 
-			// Get all Components
-			size_t compCount = 0;
-			SUModelGetNumComponentDefinitions(model, &compCount);
+				for each (Instance^ var in Instances)
+				{
+					if (Components->ContainsKey(var->ParentID))
+					{
+						System::Object^ o = Components[var->ParentID];
+						var->Parent = o;
+					}
+				}
 
-			if (compCount > 0) {
-				std::vector<SUComponentDefinitionRef> comps(compCount);
-				SUModelGetComponentDefinitions(model, compCount, &comps[0], &compCount);
+				for each (KeyValuePair<String^, Component^>^ cmp in Components)
+				{
+					FixRefs(cmp->Value);
+				}
 
-				for (size_t i = 0; i < compCount; i++) {
-					Component^ component = Component::FromSU(comps[i], includeMeshes, Materials);
-					Components->Add(component->Guid, component);
+				for each (Component^ definition in GroupDefinitions->Values)
+				{
+					FixRefs(definition);
+				}
+
+				for each (Group^ var in Groups)
+				{
+					FixRefs(var);
 				}
+
+				if (options->AnalyzeSolids)
+					AnalyzeSolids(model, entities);
+
+				PersistentIndex = nullptr;
+				if (options->IndexPersistentIds)
+					IndexPersistentIds();
+
+				Attributes = (options->Attributes != nullptr) ? AttributeTable::FromModel(model, options->Attributes) : nullptr;
+
+				InstanceInfo = (context->InstanceInfo != nullptr) ? context->InstanceInfo->ToTable() : nullptr;
+			}
+			finally
+			{
+				if (context->InstanceInfo != nullptr)
+					delete context->InstanceInfo;
+
+				SUModelRelease(&model);
+				SUTerminate();
 			}
 
-			Surfaces = Surface::GetEntitySurfaces(entities, includeMeshes, Materials);
-			Curves = Curve::GetEntityCurves(entities);
-			Edges = Edge::GetEntityEdges(entities);
-			Instances = Instance::GetEntityInstances(entities, Materials);
+			return true;
+		}
+
+		/// <summary>
+		/// Loads all faces of a SketchUp Model, including the ones nested in groups and component instances,
+		/// as merged world space triangle buffers. One MeshBatch is created per layer or per material.
+		/// Use this if you need to display or export meshes of large models.
+		/// </summary>
+		/// <param name="filename">Path to .skp file</param>
+		/// <param name="grouping">Merge faces by layer or by material</param>
+		bool LoadMeshBatches(System::String^ filename, MeshBatchGrouping grouping)
+		{
+			const char* path = Utilities::ToString(filename);
+
+			SUInitialize();
+
+			SUModelRef model = SU_INVALID;
+			SUModelLoadStatus status;
+			SUResult res = SUModelCreateFromFileWithStatus(&model, path, &status);
 
-			for each (Instance^ var in Instances)
+			if (res != SU_ERROR_NONE)
 			{
-				if (Components->ContainsKey(var->ParentID))
-				{
-					System::Object^ o = Components[var->ParentID];
-					var->Parent = o;
-				}
+				SUTerminate();
+				return false;
 			}
 
-			for each (KeyValuePair<String^, Component^>^ cmp in Components)
+			if (status == SUModelLoadStatus_Success_MoreRecent)
+				MoreRecentFileVersion = true;
+			else
+				MoreRecentFileVersion = false;
+
+			LoadMaterials(model);
+			LoadLayers(model);
+
+			MeshBatches = MeshBatch::GetModelBatches(model, grouping, Materials);
+
+			SUModelRelease(&model);
+			SUTerminate();
+			return true;
+		}
+
+		/// <summary>
+		/// Loads merged world space triangle buffers like LoadMeshBatches(String, MeshBatchGrouping)
+		/// and simplifies every batch into levels of detail (MeshBatch.Lods) in parallel.
+		/// </summary>
+		/// <param name="filename">Path to .skp file</param>
+		/// <param name="grouping">Merge faces by layer or by material</param>
+		/// <param name="lodRatios">Target triangle count of each level as fraction of the original count, e.g. 0.5, 0.1</param>
+		bool LoadMeshBatches(System::String^ filename, MeshBatchGrouping grouping, array<double>^ lodRatios)
+		{
+			if (!LoadMeshBatches(filename, grouping))
+				return false;
+
+			MeshBatch::AddLods(MeshBatches, lodRatios, Double::MaxValue);
+			return true;
+		}
+
+		/// <summary>
+		/// Builds MeshBatch.Meshlets for the merged mesh of every component and group definition,
+		/// so instances keep sharing them, and for MeshBatches. Definitions are processed in parallel.
+		/// Requires a model loaded with meshes.
+		/// </summary>
+		/// <param name="maxVertices">Largest vertex count of a meshlet, at most 256, e.g. 64</param>
+		/// <param name="maxTriangles">Largest triangle count of a meshlet, e.g. 124</param>
+		void BuildMeshlets(int maxVertices, int maxTriangles)
+		{
+			List<MeshBatch^>^ batches = gcnew List<MeshBatch^>();
+			if (Components != nullptr)
 			{
-				FixRefs(cmp->Value);
+				for each (Component^ component in Components->Values)
+					if (component->MergedMesh != nullptr) batches->Add(component->MergedMesh);
 			}
+			if (GroupDefinitions != nullptr)
+			{
+				for each (Component^ definition in GroupDefinitions->Values)
+					if (definition->MergedMesh != nullptr) batches->Add(definition->MergedMesh);
+			}
+			if (MeshBatches != nullptr)
+				batches->AddRange(MeshBatches);
+
+			MeshBatch::BuildMeshlets(batches, maxVertices, maxTriangles);
+		}
 
-			for each (Group^ var in Groups)
+		/// <summary>
+		/// Cuts all faces of a SketchUp Model, including the ones nested in groups and component instances, with planes.
+		/// Contours are stitched per layer and material, all planes are processed in parallel.
+		/// MeshBatches holds the cut meshes afterwards.
+		/// </summary>
+		/// <param name="filename">Path to .skp file</param>
+		/// <param name="planes">Planes as a,b,c,d quadruples in meters, see SectionContour::HorizontalPlanes</param>
+		bool LoadSections(System::String^ filename, array<double>^ planes)
+		{
+			if (!LoadMeshBatches(filename, MeshBatchGrouping::LayerAndMaterial))
+				return false;
+
+			Sections = SectionContour::Slice(MeshBatches, planes);
+			return true;
+		}
+
+		/// <summary>
+		/// Loads only the requested attribute dictionary keys of all entities of a SketchUp Model into columns,
+		/// without reading any geometry.
+		/// </summary>
+		/// <param name="filename">Path to .skp file</param>
+		/// <param name="projection">Attribute dictionary names and the keys to read, null or empty reads all keys</param>
+		bool LoadAttributes(System::String^ filename, Dictionary<String^, array<String^>^>^ projection)
+		{
+			const char* path = Utilities::ToString(filename);
+
+			SUInitialize();
+
+			SUModelRef model = SU_INVALID;
+			SUModelLoadStatus status;
+			SUResult res = SUModelCreateFromFileWithStatus(&model, path, &status);
+
+			if (res != SU_ERROR_NONE)
 			{
-				FixRefs(var);
+				SUTerminate();
+				return false;
 			}
 
+			MoreRecentFileVersion = (status == SUModelLoadStatus_Success_MoreRecent);
+
+			Attributes = AttributeTable::FromModel(model, projection);
 
 			SUModelRelease(&model);
 			SUTerminate();
 			return true;
+		}
 
-		};
+		/// <summary>
+		/// Loads the cameras of all scenes of a SketchUp Model into Views, without reading any geometry.
+		/// Use ViewTable.FromFiles to scan many files at once.
+		/// </summary>
+		/// <param name="filename">Path to .skp file</param>
+		bool LoadViews(System::String^ filename)
+		{
+			SUInitialize();
+			Views = ViewTable::FromFile(filename);
+			SUTerminate();
+
+			return Views != nullptr;
+		}
 
 		/// <summary>
 		/// Saves a SketchUp Model from filepath to a new file.
@@ -378,6 +651,157 @@ namespace SketchUpNET
 				}
 			}
 
+			void LoadMaterials(SUModelRef model)
+			{
+				Materials = gcnew System::Collections::Generic::Dictionary<String^, Material^>();
+
+				size_t matCount = 0;
+				SUModelGetNumMaterials(model, &matCount);
+
+				if (matCount > 0) {
+					std::vector<SUMaterialRef> materials(matCount);
+					SUModelGetMaterials(model, matCount, &materials[0], &matCount);
+
+					for (size_t i = 0; i < matCount; i++) {
+						Material^ mat = Material::FromSU(materials[i]);
+						if (!Materials->ContainsKey(mat->Name))
+							Materials->Add(mat->Name, mat);
+					}
+				}
+			}
+
+			void LoadLayers(SUModelRef model)
+			{
+				Layers = gcnew System::Collections::Generic::List<Layer^>();
+
+				size_t layerCount = 0;
+				SUModelGetNumLayers(model, &layerCount);
+
+				if (layerCount > 0) {
+					std::vector<SULayerRef> layers(layerCount);
+					SUModelGetLayers(model, layerCount, &layers[0], &layerCount);
+
+					for (size_t i = 0; i < layerCount; i++) {
+						Layer^ layer = Layer::FromSU(layers[i]);
+						Layers->Add(layer);
+					}
+				}
+			}
+
+			/// <summary>
+			/// Reads every component and group definition once, analyzes all of them in parallel
+			/// and shares the result between groups of the same definition
+			/// </summary>
+			void AnalyzeSolids(SUModelRef model, SUEntitiesRef entities)
+			{
+				SolidAnalyzer analyzer;
+				List<Component^>^ targets = gcnew List<Component^>();
+				List<int>^ indices = gcnew List<int>();
+
+				CollectSolids(analyzer, model, false, Components, targets, indices);
+				CollectSolids(analyzer, model, true, GroupDefinitions, targets, indices);
+
+				analyzer.Analyze();
+
+				array<Solid^>^ solids = gcnew array<Solid^>((int)analyzer.Definitions.size());
+				for (int i = 0; i < solids->Length; i++)
+					solids[i] = Solid::FromDefinition(analyzer.Definitions[i]);
+
+				for (int i = 0; i < targets->Count; i++)
+					targets[i]->Solid = solids[indices[i]];
+
+				AssignSolids(Groups);
+				for each (Component^ component in Components->Values)
+					AssignSolids(component->Groups);
+				for each (Component^ definition in GroupDefinitions->Values)
+					AssignSolids(definition->Groups);
+			}
+
+			void CollectSolids(SolidAnalyzer& analyzer, SUModelRef model, bool groupDefinitions, Dictionary<String^, Component^>^ loaded, List<Component^>^ targets, List<int>^ indices)
+			{
+				size_t count = 0;
+				if (groupDefinitions)
+					SUModelGetNumGroupDefinitions(model, &count);
+				else
+					SUModelGetNumComponentDefinitions(model, &count);
+				if (count == 0) return;
+
+				std::vector<SUComponentDefinitionRef> definitions(count);
+				if (groupDefinitions)
+					SUModelGetGroupDefinitions(model, count, &definitions[0], &count);
+				else
+					SUModelGetComponentDefinitions(model, count, &definitions[0], &count);
+
+				for (size_t i = 0; i < count; i++) {
+					SUStringRef guid = SU_INVALID;
+					SUStringCreate(&guid);
+					SUComponentDefinitionGetGuid(definitions[i], &guid);
+					System::String^ key = Utilities::GetString(guid);
+					SUStringRelease(&guid);
+					if (!loaded->ContainsKey(key)) continue;
+
+					SUEntitiesRef definitionEntities = SU_INVALID;
+					SUComponentDefinitionGetEntities(definitions[i], &definitionEntities);
+
+					targets->Add(loaded[key]);
+					indices->Add(analyzer.Add(definitionEntities.ptr, definitionEntities));
+				}
+			}
+
+			void AssignSolids(List<Group^>^ groups)
+			{
+				for each (Group^ group in groups)
+				{
+					if (group->Definition != nullptr)
+						group->Solid = group->Definition->Solid;
+				}
+			}
+
+			/// <summary>
+			/// Reads each group definition referenced while loading once, including the ones referenced by definitions read here,
+			/// and lets every group refer to the contents of its definition
+			/// </summary>
+			void LoadGroupDefinitions(LoadContext^ context)
+			{
+				GroupDefinitions = gcnew System::Collections::Generic::Dictionary<String^, Component^>();
+
+				while (context->PendingGroupDefinitions->Count > 0)
+				{
+					int last = context->PendingGroupDefinitions->Count - 1;
+					SUComponentDefinitionRef definition = SU_INVALID;
+					definition.ptr = context->PendingGroupDefinitions[last].ToPointer();
+					context->PendingGroupDefinitions->RemoveAt(last);
+
+					Component^ component = Component::FromSU(definition, context, Materials);
+					GroupDefinitions[component->Guid] = component;
+				}
+
+				ShareGroupDefinitions(Groups);
+				for each (Component^ component in Components->Values)
+					ShareGroupDefinitions(component->Groups);
+				for each (Component^ definition in GroupDefinitions->Values)
+					ShareGroupDefinitions(definition->Groups);
+			}
+
+			void ShareGroupDefinitions(List<Group^>^ groups)
+			{
+				for each (Group^ group in groups)
+				{
+					Component^ definition = nullptr;
+					if (group->DefinitionGuid == nullptr || !GroupDefinitions->TryGetValue(group->DefinitionGuid, definition)) continue;
+
+					group->Definition = definition;
+					group->Surfaces = definition->Surfaces;
+					group->Edges = definition->Edges;
+					group->Curves = definition->Curves;
+					group->Instances = definition->Instances;
+					group->Groups = definition->Groups;
+					group->Arcs = definition->Arcs;
+					group->Annotations = definition->Annotations;
+					group->Images = definition->Images;
+				}
+			}
+
 			void FixRefs(Component^ comp)
 			{
 				for each (Instance^ var in comp->Instances)
@@ -392,6 +816,89 @@ namespace SketchUpNET
 				}
 			}
 
+			/// <summary>
+			/// Collects the definitions of visible instances, descending into visible groups and collected definitions
+			/// </summary>
+			void CollectDefinitions(SUEntitiesRef entities, LoadContext^ context, HashSet<IntPtr>^ visited, std::vector<SUComponentDefinitionRef>& definitions)
+			{
+				size_t count = 0;
+				SUEntitiesGetNumInstances(entities, &count);
+				if (count > 0)
+				{
+					std::vector<SUComponentInstanceRef> instances(count);
+					SUEntitiesGetInstances(entities, count, &instances[0], &count);
+					for (size_t i = 0; i < count; i++)
+					{
+						if (!context->IsVisible(SUComponentInstanceToDrawingElement(instances[i]))) continue;
+
+						SUComponentDefinitionRef definition = SU_INVALID;
+						SUComponentInstanceGetDefinition(instances[i], &definition);
+						if (SUIsInvalid(definition) || !visited->Add(IntPtr(definition.ptr))) continue;
+
+						definitions.push_back(definition);
+						SUEntitiesRef definitionEntities = SU_INVALID;
+						SUComponentDefinitionGetEntities(definition, &definitionEntities);
+						CollectDefinitions(definitionEntities, context, visited, definitions);
+					}
+				}
+
+				count = 0;
+				SUEntitiesGetNumGroups(entities, &count);
+				if (count > 0)
+				{
+					std::vector<SUGroupRef> groups(count);
+					SUEntitiesGetGroups(entities, count, &groups[0], &count);
+					for (size_t i = 0; i < count; i++)
+					{
+						if (!context->IsVisible(SUGroupToDrawingElement(groups[i]))) continue;
+
+						// Copies of a group share their definition, its contents are visited once
+						SUComponentDefinitionRef definition = SU_INVALID;
+						SUGroupGetDefinition(groups[i], &definition);
+						if (!SUIsInvalid(definition) && !visited->Add(IntPtr(definition.ptr))) continue;
+
+						SUEntitiesRef groupEntities = SU_INVALID;
+						SUGroupGetEntities(groups[i], &groupEntities);
+						CollectDefinitions(groupEntities, context, visited, definitions);
+					}
+				}
+			}
+
+			void IndexPersistentIds()
+			{
+				PersistentIndex = gcnew System::Collections::Generic::Dictionary<Int64, Object^>();
+				IndexEntities(Surfaces, Edges, Instances, Groups);
+
+				for each (Component^ component in Components->Values)
+				{
+					PersistentIndex[component->PersistentId] = component;
+					IndexEntities(component->Surfaces, component->Edges, component->Instances, component->Groups);
+				}
+
+				for each (Component^ definition in GroupDefinitions->Values)
+				{
+					PersistentIndex[definition->PersistentId] = definition;
+					IndexEntities(definition->Surfaces, definition->Edges, definition->Instances, definition->Groups);
+				}
+			}
+
+			void IndexEntities(List<Surface^>^ surfaces, List<Edge^>^ edges, List<Instance^>^ instances, List<Group^>^ groups)
+			{
+				for each (Surface^ surface in surfaces)
+					PersistentIndex[surface->PersistentId] = surface;
+				for each (Edge^ edge in edges)
+					PersistentIndex[edge->PersistentId] = edge;
+				for each (Instance^ instance in instances)
+					PersistentIndex[instance->PersistentId] = instance;
+				// Contents of groups are indexed with their group definition
+				for each (Group^ group in groups)
+				{
+					PersistentIndex[group->PersistentId] = group;
+					if (group->Definition == nullptr)
+						IndexEntities(group->Surfaces, group->Edges, group->Instances, group->Groups);
+				}
+			}
+
 			void FixRefs(Group^ comp)
 			{
 				for each (Instance^ var in comp->Instances)
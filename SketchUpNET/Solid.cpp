@@ -0,0 +1,276 @@
+/*
+
+SketchUpNET - a C++ Wrapper for the Trimble(R) SketchUp(R) C API
+Copyright(C) 2015, Autor: Maximilian Thumfart
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <SketchUpAPI/slapi.h>
+#include <SketchUpAPI/geometry.h>
+#include <SketchUpAPI/model/entities.h>
+#include <SketchUpAPI/model/face.h>
+#include <SketchUpAPI/model/loop.h>
+#include <SketchUpAPI/model/vertex.h>
+#include <msclr/marshal.h>
+#include <vector>
+#include <map>
+#include <cmath>
+#include "utilities.h"
+#include "Transform.h"
+#include "Triangulator.h"
+
+using namespace System;
+using namespace System::Collections;
+using namespace System::Collections::Generic;
+
+namespace SketchUpNET
+{
+	/// <summary>
+	/// Faces of one group or component definition as flat rings, plus the analysis results
+	/// </summary>
+	struct SolidDefinition
+	{
+		std::vector<double> Points;
+		std::vector<int> VertexIds;
+		std::vector<int> RingOffsets;
+		std::vector<int> FaceRings;
+		bool HasLooseEntities;
+		bool IsClosed;
+		double Volume;
+		double Area;
+
+		SolidDefinition() : RingOffsets(1, 0), HasLooseEntities(false), IsClosed(false), Volume(0), Area(0) {}
+
+		void Read(SUEntitiesRef entities)
+		{
+			// Solids consist of faces and their edges only
+			size_t groupCount = 0, instanceCount = 0, looseEdgeCount = 0;
+			SUEntitiesGetNumGroups(entities, &groupCount);
+			SUEntitiesGetNumInstances(entities, &instanceCount);
+			SUEntitiesGetNumEdges(entities, true, &looseEdgeCount);
+			HasLooseEntities = groupCount > 0 || instanceCount > 0 || looseEdgeCount > 0;
+
+			size_t faceCount = 0;
+			SUEntitiesGetNumFaces(entities, &faceCount);
+			if (faceCount == 0) return;
+
+			std::vector<SUFaceRef> faces(faceCount);
+			SUEntitiesGetFaces(entities, faceCount, &faces[0], &faceCount);
+
+			std::map<void*, int> ids;
+			for (size_t i = 0; i < faceCount; i++)
+			{
+				FaceRings.push_back((int)RingOffsets.size() - 1);
+
+				SULoopRef outer = SU_INVALID;
+				SUFaceGetOuterLoop(faces[i], &outer);
+				ReadLoop(outer, ids);
+
+				size_t innerCount = 0;
+				SUFaceGetNumInnerLoops(faces[i], &innerCount);
+				if (innerCount > 0)
+				{
+					std::vector<SULoopRef> loops(innerCount);
+					SUFaceGetInnerLoops(faces[i], innerCount, &loops[0], &innerCount);
+					for (size_t j = 0; j < innerCount; j++)
+						ReadLoop(loops[j], ids);
+				}
+			}
+			FaceRings.push_back((int)RingOffsets.size() - 1);
+		}
+
+		/// <summary>
+		/// Checks closure by counting the uses of every edge and sums volume and area over the triangulated faces
+		/// </summary>
+		void Analyze()
+		{
+			int faceCount = (int)FaceRings.size() - 1;
+			if (faceCount < 1) return;
+
+			// In a closed manifold shell every edge bounds exactly two faces
+			std::map<std::pair<int, int>, int> edgeUses;
+			bool closed = !HasLooseEntities;
+			for (size_t r = 0; r + 1 < RingOffsets.size(); r++)
+			{
+				int start = RingOffsets[r];
+				int end = RingOffsets[r + 1];
+				for (int i = start; i < end; i++)
+				{
+					int a = VertexIds[i];
+					int b = VertexIds[(i + 1 < end) ? i + 1 : start];
+					edgeUses[std::make_pair((std::min)(a, b), (std::max)(a, b))]++;
+				}
+			}
+			for (std::map<std::pair<int, int>, int>::const_iterator it = edgeUses.begin(); it != edgeUses.end(); ++it)
+				if (it->second != 2) closed = false;
+
+			// Divergence theorem over triangles wound along the face normals
+			std::vector<int> indices;
+			for (int f = 0; f < faceCount; f++)
+			{
+				indices.clear();
+				if (!PolygonTriangulator::Triangulate(&Points[0], &RingOffsets[FaceRings[f]], FaceRings[f + 1] - FaceRings[f], indices))
+					continue;
+
+				for (size_t t = 0; t < indices.size(); t = t + 3)
+				{
+					const double* a = &Points[3 * indices[t]];
+					const double* b = &Points[3 * indices[t + 1]];
+					const double* c = &Points[3 * indices[t + 2]];
+
+					double cross[3] = {
+						(b[1] - a[1]) * (c[2] - a[2]) - (b[2] - a[2]) * (c[1] - a[1]),
+						(b[2] - a[2]) * (c[0] - a[0]) - (b[0] - a[0]) * (c[2] - a[2]),
+						(b[0] - a[0]) * (c[1] - a[1]) - (b[1] - a[1]) * (c[0] - a[0]) };
+
+					Area += 0.5 * sqrt(cross[0] * cross[0] + cross[1] * cross[1] + cross[2] * cross[2]);
+					Volume += (a[0] * (b[1] * c[2] - b[2] * c[1]) + a[1] * (b[2] * c[0] - b[0] * c[2]) + a[2] * (b[0] * c[1] - b[1] * c[0])) / 6.0;
+				}
+			}
+
+			IsClosed = closed;
+		}
+
+	private:
+		void ReadLoop(SULoopRef loop, std::map<void*, int>& ids)
+		{
+			size_t count = 0;
+			SULoopGetNumVertices(loop, &count);
+			if (count > 0)
+			{
+				std::vector<SUVertexRef> vertices(count);
+				SULoopGetVertices(loop, count, &vertices[0], &count);
+
+				for (size_t i = 0; i < count; i++)
+				{
+					std::map<void*, int>::iterator it = ids.find(vertices[i].ptr);
+					if (it == ids.end())
+						it = ids.insert(std::make_pair(vertices[i].ptr, (int)ids.size())).first;
+					VertexIds.push_back(it->second);
+
+					SUPoint3D pt = SU_INVALID;
+					SUVertexGetPosition(vertices[i], &pt);
+					Points.push_back(pt.x * 0.0254);
+					Points.push_back(pt.y * 0.0254);
+					Points.push_back(pt.z * 0.0254);
+				}
+			}
+			RingOffsets.push_back((int)VertexIds.size());
+		}
+	};
+
+	struct SolidKernel
+	{
+		SolidDefinition* Definitions;
+
+		void operator()(int index) const
+		{
+			Definitions[index].Analyze();
+		}
+	};
+
+	/// <summary>
+	/// Reads every definition once and analyzes all of them in parallel
+	/// </summary>
+	class SolidAnalyzer
+	{
+	public:
+		std::vector<SolidDefinition> Definitions;
+
+		/// <summary>
+		/// Returns the index of a definition, reading its faces on first use
+		/// </summary>
+		int Add(void* definition, SUEntitiesRef entities)
+		{
+			std::map<void*, int>::iterator it = indices.find(definition);
+			if (it != indices.end()) return it->second;
+
+			int index = (int)Definitions.size();
+			indices[definition] = index;
+			Definitions.push_back(SolidDefinition());
+			Definitions.back().Read(entities);
+			return index;
+		}
+
+		void Analyze()
+		{
+			if (Definitions.empty()) return;
+
+			SolidKernel kernel;
+			kernel.Definitions = &Definitions[0];
+			Utilities::ParallelFor((int)Definitions.size(), kernel);
+		}
+
+	private:
+		std::map<void*, int> indices;
+	};
+
+	/// <summary>
+	/// Closure, volume and surface area of a group or component definition
+	/// </summary>
+	public ref class Solid
+	{
+	public:
+		/// <summary>
+		/// All edges bound exactly two faces and there are no loose edges, groups or instances
+		/// </summary>
+		bool IsClosed;
+
+		/// <summary>
+		/// Signed volume in cubic meters, positive if face normals point outwards. Only meaningful if closed.
+		/// </summary>
+		double Volume;
+
+		/// <summary>
+		/// Surface area in square meters
+		/// </summary>
+		double Area;
+
+		Solid(bool isClosed, double volume, double area)
+		{
+			this->IsClosed = isClosed;
+			this->Volume = volume;
+			this->Area = area;
+		};
+
+		Solid(){};
+
+		/// <summary>
+		/// Returns volume and area scaled by a group or instance transformation.
+		/// Areas are exact for uniform scaling only.
+		/// </summary>
+		/// <param name="transformation">Transformation to apply</param>
+		Solid^ Transformed(Transform^ transformation)
+		{
+			double m[16];
+			transformation->CopyTo(m);
+			double determinant = TransformMath::Determinant(m);
+
+			return gcnew Solid(this->IsClosed, this->Volume * determinant, this->Area * pow(fabs(determinant), 2.0 / 3.0));
+		}
+
+	internal:
+		static Solid^ FromDefinition(const SolidDefinition& definition)
+		{
+			return gcnew Solid(definition.IsClosed, definition.Volume, definition.Area);
+		}
+	};
+
+
+}
@@ -40,6 +40,11 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "utilities.h"
 #include "Mesh.h"
 #include "Material.h"
+#include "PointRings.h"
+#include "Opening.h"
+#include "LoadContext.h"
+#include "Triangulator.h"
+#include "MeshBatch.h"
 
 using namespace System;
 using namespace System::Collections;
@@ -92,6 +97,21 @@ namespace SketchUpNET
 
 		System::String^ Layer;
 
+		/// <summary>
+		/// Persistent id of the face, see ModelSession
+		/// </summary>
+		Int64 PersistentId;
+
+		/// <summary>
+		/// Outer loop followed by inner loops as compact point rings, if loops have been read as points
+		/// </summary>
+		PointRings^ Rings;
+
+		/// <summary>
+		/// Openings cut into this face by glued components, one ring per opening, if loaded with Openings
+		/// </summary>
+		PointRings^ Openings;
+
 		Surface(Loop^ outer, List<Loop^>^ inner, Vector^ normal, double area, List<Vertex^>^ vertices, Mesh^ m, System::String^ layername, Material^ backmat, Material^ frontmat)
 		{
 			this->OuterEdges = outer;
@@ -133,8 +153,140 @@ namespace SketchUpNET
 			this->OuterEdges = outer;
 		};
 
+		/// <summary>
+		/// Triangulates the outer and inner loops of this surface without a SketchUp model,
+		/// e.g. to preview surfaces or to validate them before writing.
+		/// Returns null if the loops can't be triangulated.
+		/// </summary>
+		Mesh^ Triangulate()
+		{
+			std::vector<double> points;
+			std::vector<int> offsets(1, 0);
+			AppendRings(points, offsets);
+
+			std::vector<int> indices;
+			if (points.empty() || !PolygonTriangulator::Triangulate(&points[0], &offsets[0], (int)offsets.size() - 1, indices))
+				return nullptr;
+
+			double normal[3];
+			PolygonTriangulator::Newell(&points[0], offsets[0], offsets[1], normal);
+			double length = sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+
+			List<Vertex^>^ vertices = gcnew List<Vertex^>();
+			List<Vector^>^ normals = gcnew List<Vector^>();
+			for (size_t i = 0; i < points.size(); i = i + 3)
+			{
+				vertices->Add(gcnew Vertex(points[i], points[i + 1], points[i + 2]));
+				normals->Add(gcnew Vector(normal[0] / length, normal[1] / length, normal[2] / length));
+			}
+
+			List<MeshFace^>^ faces = gcnew List<MeshFace^>();
+			for (size_t i = 0; i < indices.size(); i = i + 3)
+				faces->Add(gcnew MeshFace(indices[i], indices[i + 1], indices[i + 2]));
+
+			return gcnew Mesh(vertices, normals, faces, this->Layer);
+		}
+
+		/// <summary>
+		/// Triangulates many surfaces across threads into a single mesh batch without a SketchUp model.
+		/// FaceIds holds the index of the source surface of each triangle,
+		/// surfaces which can't be triangulated have no triangles.
+		/// </summary>
+		/// <param name="surfaces">Surfaces to triangulate</param>
+		static MeshBatch^ Triangulate(List<Surface^>^ surfaces)
+		{
+			std::vector<double> points;
+			std::vector<int> ringOffsets(1, 0);
+			std::vector<int> faceRings;
+			faceRings.reserve(surfaces->Count + 1);
+
+			for each (Surface^ surface in surfaces)
+			{
+				faceRings.push_back((int)ringOffsets.size() - 1);
+				surface->AppendRings(points, ringOffsets);
+			}
+			faceRings.push_back((int)ringOffsets.size() - 1);
+
+			std::vector<std::vector<int> > triangles(surfaces->Count);
+			std::vector<double> normals(points.size());
+
+			if (!points.empty())
+			{
+				TriangulationKernel kernel;
+				kernel.Points = &points[0];
+				kernel.RingOffsets = &ringOffsets[0];
+				kernel.FaceRings = &faceRings[0];
+				kernel.Triangles = &triangles[0];
+				kernel.Normals = &normals[0];
+				Utilities::ParallelFor(surfaces->Count, kernel);
+			}
+
+			std::vector<int> indices;
+			std::vector<int> faceIds;
+			for (size_t i = 0; i < triangles.size(); i++)
+			{
+				indices.insert(indices.end(), triangles[i].begin(), triangles[i].end());
+				faceIds.insert(faceIds.end(), triangles[i].size() / 3, (int)i);
+			}
+
+			MeshBatch^ v = gcnew MeshBatch(System::String::Empty, System::String::Empty, nullptr,
+				Utilities::ToArray(points), Utilities::ToArray(normals), gcnew array<double>(0), Utilities::ToArray(indices));
+			v->FaceIds = Utilities::ToArray(faceIds);
+
+			return v;
+		}
+
 	internal:
 
+		/// <summary>
+		/// Appends the outer loop followed by the inner loops as flat points and ring end offsets
+		/// </summary>
+		void AppendRings(std::vector<double>& points, std::vector<int>& offsets)
+		{
+			if (Rings != nullptr && Rings->Count > 0)
+			{
+				int start = (int)(points.size() / 3) - Rings->Offsets[0];
+				for each (double value in Rings->Points)
+					points.push_back(value);
+				for (int i = 1; i < Rings->Offsets->Length; i++)
+					offsets.push_back(start + Rings->Offsets[i]);
+				return;
+			}
+
+			if (OuterEdges != nullptr && OuterEdges->Edges != nullptr && OuterEdges->Edges->Count > 0)
+				AppendLoop(OuterEdges, points);
+			else if (Vertices != nullptr)
+			{
+				// Surfaces created from outer vertices only, see ToSU
+				for each (Vertex^ vertex in Vertices)
+				{
+					points.push_back(vertex->X);
+					points.push_back(vertex->Y);
+					points.push_back(vertex->Z);
+				}
+			}
+			offsets.push_back((int)(points.size() / 3));
+
+			if (InnerEdges != nullptr)
+			{
+				for each (Loop^ loop in InnerEdges)
+				{
+					AppendLoop(loop, points);
+					offsets.push_back((int)(points.size() / 3));
+				}
+			}
+		}
+
+		static void AppendLoop(Loop^ loop, std::vector<double>& points)
+		{
+			for each (Edge^ edge in loop->Edges)
+			{
+				points.push_back(edge->Start->X);
+				points.push_back(edge->Start->Y);
+				points.push_back(edge->Start->Z);
+			}
+		}
+
 		static Vertex^ GetCentroid(List<Vertex^>^ vertices, int vertexCount)
 		{
 			Vertex^ centroid = gcnew Vertex(0, 0, vertices[0]->Z);
@@ -232,7 +384,7 @@ namespace SketchUpNET
 			return result;
 		}
 
-		static Surface^ FromSU(SUFaceRef face, bool includeMeshes, System::Collections::Generic::Dictionary<String^, Material^>^ materials)
+		static Surface^ FromSU(SUFaceRef face, LoadContext^ context, System::Collections::Generic::Dictionary<String^, Material^>^ materials)
 		{
 			List<Loop^>^ inner = gcnew List<Loop^>();
 			
@@ -240,7 +392,8 @@ namespace SketchUpNET
 			SUFaceGetOuterLoop(face, &outer);
 			
 			size_t edgeCount = 0;
-			SUFaceGetNumInnerLoops(face, &edgeCount);
+			if (!context->Options->LoopsAsPoints)
+				SUFaceGetNumInnerLoops(face, &edgeCount);
 			if (edgeCount > 0)
 			{
 				std::vector<SULoopRef> loops(edgeCount);
@@ -288,7 +441,7 @@ namespace SketchUpNET
 				}
 			}
 
-			Mesh^ m = (includeMeshes)? Mesh::FromSU(face) : nullptr;
+			Mesh^ m = (context->Options->IncludeMeshes)? Mesh::FromSU(face) : nullptr;
 
 			SUMaterialRef mback = SU_INVALID;
 			SUFaceGetBackMaterial(face, &mback);
@@ -308,13 +461,23 @@ namespace SketchUpNET
 			Material^ backMat = (materials->ContainsKey(mbackName)) ? materials[mbackName] : Material::FromSU(mback);
 			Material^ frontMat = (materials->ContainsKey(minnerName)) ? materials[minnerName] : Material::FromSU(minner);
 
-			Surface^ v = gcnew Surface(Loop::FromSU(outer), inner, normal, area, vertices,m, layername, backMat, frontMat);
+			Loop^ outerLoop = (context->Options->LoopsAsPoints) ? gcnew Loop(gcnew List<Edge^>()) : Loop::FromSU(outer);
+
+			Surface^ v = gcnew Surface(outerLoop, inner, normal, area, vertices,m, layername, backMat, frontMat);
+
+			if (context->Options->LoopsAsPoints)
+				v->Rings = PointRings::FromFace(face);
+
+			if (context->Options->Openings)
+				v->Openings = Opening::FromFace(face);
+
+			v->PersistentId = Utilities::GetPersistentId(SUFaceToEntity(face));
 
 			return v;
 		}
 
 
-		static List<Surface^>^ GetEntitySurfaces(SUEntitiesRef entities, bool includeMeshes, System::Collections::Generic::Dictionary<String^, Material^>^ materials)
+		static List<Surface^>^ GetEntitySurfaces(SUEntitiesRef entities, LoadContext^ context, System::Collections::Generic::Dictionary<String^, Material^>^ materials)
 		{
 			List<Surface^>^ surfaces = gcnew List<Surface^>();
 
@@ -327,7 +490,9 @@ namespace SketchUpNET
 
 
 				for (size_t i = 0; i < faceCount; i++) {
-					Surface^ surface = Surface::FromSU(faces[i], includeMeshes, materials);
+					if (!context->IsVisible(SUFaceToDrawingElement(faces[i]))) continue;
+
+					Surface^ surface = Surface::FromSU(faces[i], context, materials);
 					surfaces->Add(surface);
 				}
 			}
@@ -34,6 +34,8 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include <msclr/marshal.h>
 #include <SketchUpAPI/model/component_instance.h>
 #include <vector>
+#include <cmath>
+#include <cstring>
 #include "vertex.h"
 
 using namespace System;
@@ -57,9 +59,9 @@ namespace SketchUpNET
 			transformedPoint->Y = (this->Data[1] * point->X) + (point->Y*this->Data[5]) + (point->Z*this->Data[9]) + this->Data[13];
 			transformedPoint->Z = (this->Data[2] * point->X) + (point->Y*this->Data[6]) + (point->Z*this->Data[10]) + this->Data[14];
 
-			transformedPoint->X = transformedPoint->X* this->Scale;
-			transformedPoint->Y = transformedPoint->Y* this->Scale;
-			transformedPoint->Z = transformedPoint->Z* this->Scale;
+			transformedPoint->X = transformedPoint->X* uniform_scale_factor;
+			transformedPoint->Y = transformedPoint->Y* uniform_scale_factor;
+			transformedPoint->Z = transformedPoint->Z* uniform_scale_factor;
 
 			return transformedPoint;
 		}
@@ -84,6 +86,12 @@ namespace SketchUpNET
 
 		Transform(){};
 	internal:
+		void CopyTo(double* values)
+		{
+			for (int i = 0; i < 16; i++)
+				values[i] = this->Data[i];
+		}
+
 		static Transform^ FromSU(SUTransformation transformation)
 		{
 			double* data = transformation.values;
@@ -103,5 +111,134 @@ namespace SketchUpNET
 
 	};
 
+	/// <summary>
+	/// Native helpers for 4x4 column major matrices as stored in SUTransformation::values
+	/// </summary>
+	class TransformMath
+	{
+	public:
+
+		static void Identity(double* m)
+		{
+			memset(m, 0, 16 * sizeof(double));
+			m[0] = m[5] = m[10] = m[15] = 1.0;
+		}
+
+		/// <summary>
+		/// out = a * b
+		/// </summary>
+		static void Multiply(const double* a, const double* b, double* out)
+		{
+			double r[16];
+			for (int col = 0; col < 4; col++)
+				for (int row = 0; row < 4; row++)
+					r[col * 4 + row] = a[row] * b[col * 4] + a[4 + row] * b[col * 4 + 1] + a[8 + row] * b[col * 4 + 2] + a[12 + row] * b[col * 4 + 3];
+			memcpy(out, r, sizeof(r));
+		}
+
+		static void TransformPoint(const double* m, const double* p, double* out)
+		{
+			double x = m[0] * p[0] + m[4] * p[1] + m[8] * p[2] + m[12];
+			double y = m[1] * p[0] + m[5] * p[1] + m[9] * p[2] + m[13];
+			double z = m[2] * p[0] + m[6] * p[1] + m[10] * p[2] + m[14];
+			double w = m[3] * p[0] + m[7] * p[1] + m[11] * p[2] + m[15];
+
+			if (w != 0.0 && w != 1.0)
+			{
+				x /= w;
+				y /= w;
+				z /= w;
+			}
+
+			out[0] = x;
+			out[1] = y;
+			out[2] = z;
+		}
+
+		static double Determinant(const double* m)
+		{
+			double det = m[0] * (m[5] * m[10] - m[9] * m[6])
+				- m[4] * (m[1] * m[10] - m[9] * m[2])
+				+ m[8] * (m[1] * m[6] - m[5] * m[2]);
+
+			if (m[15] != 0.0 && m[15] != 1.0)
+				det /= m[15] * m[15] * m[15];
+
+			return det;
+		}
+
+		/// <summary>
+		/// Row major 3x3 matrix transforming normals (inverse transpose up to scale),
+		/// valid for non-uniform scaling and mirroring
+		/// </summary>
+		static void NormalMatrix(const double* m, double* n)
+		{
+			const double* a0 = &m[0];
+			const double* a1 = &m[4];
+			const double* a2 = &m[8];
+
+			double c0[3] = { a1[1] * a2[2] - a1[2] * a2[1], a1[2] * a2[0] - a1[0] * a2[2], a1[0] * a2[1] - a1[1] * a2[0] };
+			double c1[3] = { a2[1] * a0[2] - a2[2] * a0[1], a2[2] * a0[0] - a2[0] * a0[2], a2[0] * a0[1] - a2[1] * a0[0] };
+			double c2[3] = { a0[1] * a1[2] - a0[2] * a1[1], a0[2] * a1[0] - a0[0] * a1[2], a0[0] * a1[1] - a0[1] * a1[0] };
+
+			double sign = (Determinant(m) < 0) ? -1.0 : 1.0;
+
+			for (int row = 0; row < 3; row++)
+			{
+				n[row * 3 + 0] = c0[row] * sign;
+				n[row * 3 + 1] = c1[row] * sign;
+				n[row * 3 + 2] = c2[row] * sign;
+			}
+		}
+
+		static void TransformNormal(const double* n, const double* v, double* out)
+		{
+			double x = n[0] * v[0] + n[1] * v[1] + n[2] * v[2];
+			double y = n[3] * v[0] + n[4] * v[1] + n[5] * v[2];
+			double z = n[6] * v[0] + n[7] * v[1] + n[8] * v[2];
+			double length = sqrt(x * x + y * y + z * z);
+
+			if (length > 0.0)
+			{
+				x /= length;
+				y /= length;
+				z /= length;
+			}
+
+			out[0] = x;
+			out[1] = y;
+			out[2] = z;
+		}
+
+		/// <summary>
+		/// Inverts an affine transformation, returns false if it is singular
+		/// </summary>
+		static bool Invert(const double* m, double* out)
+		{
+			double w = (m[15] != 0.0) ? m[15] : 1.0;
+			double a[16];
+			for (int i = 0; i < 16; i++)
+				a[i] = m[i] / w;
+
+			double det = Determinant(a);
+			if (fabs(det) < 1e-18) return false;
+
+			double n[9];
+			NormalMatrix(a, n);
+			double sign = (det < 0) ? -1.0 : 1.0;
+
+			Identity(out);
+			for (int row = 0; row < 3; row++)
+				for (int col = 0; col < 3; col++)
+					out[col * 4 + row] = n[col * 3 + row] * sign / det;
+
+			for (int row = 0; row < 3; row++)
+				out[12 + row] = -(out[row] * a[12] + out[4 + row] * a[13] + out[8 + row] * a[14]);
+
+			return true;
+		}
+
+	};
+
 
 }
\ No newline at end of file
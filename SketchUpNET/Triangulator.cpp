@@ -0,0 +1,373 @@
+/*
+
+SketchUpNET - a C++ Wrapper for the Trimble(R) SketchUp(R) C API
+Copyright(C) 2015, Autor: Maximilian Thumfart
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+namespace SketchUpNET
+{
+	/// <summary>
+	/// Ear clipping triangulator for planar polygons with holes.
+	/// Rings are passed as flat x,y,z buffers with ring offsets, outer ring first.
+	/// </summary>
+	class PolygonTriangulator
+	{
+	public:
+		/// <summary>
+		/// Newell normal of the points [start, end), not normalized. Its length is twice the ring area.
+		/// </summary>
+		static void Newell(const double* points, int start, int end, double* normal)
+		{
+			normal[0] = normal[1] = normal[2] = 0;
+			for (int i = start; i < end; i++)
+			{
+				const double* a = &points[3 * i];
+				const double* b = &points[3 * ((i + 1 < end) ? i + 1 : start)];
+				normal[0] += (a[1] - b[1]) * (a[2] + b[2]);
+				normal[1] += (a[2] - b[2]) * (a[0] + b[0]);
+				normal[2] += (a[0] - b[0]) * (a[1] + b[1]);
+			}
+		}
+
+		/// <summary>
+		/// Appends triangles as indices into points. Triangles are wound along the outer ring's normal.
+		/// Returns false if the polygon is degenerate or can't be triangulated.
+		/// </summary>
+		/// <param name="points">Ring points as x,y,z triplets</param>
+		/// <param name="offsets">Index of the first point of each ring, followed by the end of the last ring</param>
+		/// <param name="ringCount">Number of rings</param>
+		/// <param name="indices">Triangle indices are appended here</param>
+		static bool Triangulate(const double* points, const int* offsets, int ringCount, std::vector<int>& indices)
+		{
+			if (ringCount < 1 || offsets[1] - offsets[0] < 3) return false;
+
+			double normal[3];
+			Newell(points, offsets[0], offsets[1], normal);
+
+			// Project onto the coordinate plane most parallel to the face
+			int axis = 0;
+			for (int i = 1; i < 3; i++)
+				if (fabs(normal[i]) > fabs(normal[axis])) axis = i;
+			if (normal[axis] == 0) return false;
+
+			PolygonTriangulator triangulator(points, (axis + 1) % 3, (axis + 2) % 3);
+
+			int outer = triangulator.CreateRing(offsets[0], offsets[1], true);
+			if (outer < 0) return false;
+
+			std::vector<std::pair<double, int> > holes;
+			for (int i = 1; i < ringCount; i++)
+			{
+				int hole = triangulator.CreateRing(offsets[i], offsets[i + 1], false);
+				if (hole < 0) continue;
+				holes.push_back(std::make_pair(-triangulator.nodes[triangulator.RightMost(hole)].X, hole));
+			}
+
+			// Bridge holes from right to left, so each bridge sees the holes merged before
+			std::sort(holes.begin(), holes.end());
+			for (size_t i = 0; i < holes.size(); i++)
+				if (!triangulator.EliminateHole(holes[i].second, outer)) return false;
+
+			return triangulator.ClipEars(outer, indices);
+		}
+
+	private:
+		struct Node
+		{
+			int Index;
+			double X, Y;
+			int Prev, Next;
+		};
+
+		const double* points;
+		int ax, ay;
+		bool flip;
+		double epsilon;
+		std::vector<Node> nodes;
+
+		PolygonTriangulator(const double* points, int ax, int ay)
+		{
+			this->points = points;
+			this->ax = ax;
+			this->ay = ay;
+			this->flip = false;
+			this->epsilon = 0;
+		}
+
+		double Cross(int a, int b, int c) const
+		{
+			return (nodes[b].X - nodes[a].X) * (nodes[c].Y - nodes[a].Y) - (nodes[b].Y - nodes[a].Y) * (nodes[c].X - nodes[a].X);
+		}
+
+		bool SamePosition(int a, int b) const
+		{
+			return nodes[a].X == nodes[b].X && nodes[a].Y == nodes[b].Y;
+		}
+
+		// Inclusive test, triangle a,b,c counter clockwise
+		bool InTriangle(int a, int b, int c, int p) const
+		{
+			return Cross(a, b, p) >= -epsilon && Cross(b, c, p) >= -epsilon && Cross(c, a, p) >= -epsilon;
+		}
+
+		int AddNode(int index, double x, double y)
+		{
+			Node node;
+			node.Index = index;
+			node.X = x;
+			node.Y = y;
+			node.Prev = node.Next = -1;
+			nodes.push_back(node);
+			return (int)nodes.size() - 1;
+		}
+
+		void Link(int a, int b)
+		{
+			nodes[a].Next = b;
+			nodes[b].Prev = a;
+		}
+
+		void Unlink(int node)
+		{
+			Link(nodes[node].Prev, nodes[node].Next);
+		}
+
+		// Creates a circular list of the points [start, end), counter clockwise for outer rings and clockwise for holes
+		int CreateRing(int start, int end, bool outer)
+		{
+			if (end - start < 3) return -1;
+
+			double area = 0;
+			for (int i = start, j = end - 1; i < end; j = i++)
+				area += (points[3 * j + ax] - points[3 * i + ax]) * (points[3 * i + ay] + points[3 * j + ay]);
+			area *= 0.5;
+			if (area == 0) return -1;
+
+			if (outer)
+			{
+				flip = area < 0;
+				double size = 0;
+				for (int i = start; i < end; i++)
+					size = (std::max)(size, (std::max)(fabs(points[3 * i + ax]), fabs(points[3 * i + ay])));
+				epsilon = size * size * 1e-14;
+			}
+
+			bool reverse = (area > 0) != outer;
+			int first = -1;
+			int last = -1;
+			for (int k = 0; k < end - start; k++)
+			{
+				int i = reverse ? end - 1 - k : start + k;
+				int node = AddNode(i, points[3 * i + ax], points[3 * i + ay]);
+				if (last < 0) first = node;
+				else Link(last, node);
+				last = node;
+			}
+			Link(last, first);
+			return first;
+		}
+
+		int RightMost(int ring) const
+		{
+			int best = ring;
+			int node = ring;
+			do
+			{
+				if (nodes[node].X > nodes[best].X) best = node;
+				node = nodes[node].Next;
+			} while (node != ring);
+			return best;
+		}
+
+		// Connects a hole to the outer ring with a pair of coincident bridge edges (Eberly)
+		bool EliminateHole(int hole, int outer)
+		{
+			int m = RightMost(hole);
+			double mx = nodes[m].X;
+			double my = nodes[m].Y;
+
+			// Closest outer edge hit by a ray from m towards +x
+			int candidate = -1;
+			double hitX = 0;
+			int node = outer;
+			do
+			{
+				int next = nodes[node].Next;
+				const Node& a = nodes[node];
+				const Node& b = nodes[next];
+				if (a.Y != b.Y && ((a.Y <= my && my <= b.Y) || (b.Y <= my && my <= a.Y)))
+				{
+					double x = a.X + (my - a.Y) * (b.X - a.X) / (b.Y - a.Y);
+					if (x >= mx && (candidate < 0 || x < hitX))
+					{
+						hitX = x;
+						candidate = (a.X > b.X) ? node : next;
+					}
+				}
+				node = next;
+			} while (node != outer);
+
+			if (candidate < 0) return false;
+
+			// Outer vertices inside the triangle m, hit, candidate would block the bridge,
+			// take the one with the smallest angle to the ray instead
+			int bridge = candidate;
+			if (hitX != nodes[candidate].X || my != nodes[candidate].Y)
+			{
+				int hit = AddNode(-1, hitX, my);
+				int a = m, b = hit, c = candidate;
+				if (Cross(a, b, c) < 0) std::swap(b, c);
+
+				double best = -1;
+				node = outer;
+				do
+				{
+					if (node != candidate && nodes[node].X > mx && InTriangle(a, b, c, node))
+					{
+						double tangent = fabs(nodes[node].Y - my) / (nodes[node].X - mx);
+						if (best < 0 || tangent < best || (tangent == best && nodes[node].X < nodes[bridge].X))
+						{
+							best = tangent;
+							bridge = node;
+						}
+					}
+					node = nodes[node].Next;
+				} while (node != outer);
+			}
+
+			// outer: bridge -> m -> hole ... -> m' -> bridge' -> bridge.next
+			int bridge2 = AddNode(nodes[bridge].Index, nodes[bridge].X, nodes[bridge].Y);
+			int m2 = AddNode(nodes[m].Index, nodes[m].X, nodes[m].Y);
+			int bridgeNext = nodes[bridge].Next;
+			int mPrev = nodes[m].Prev;
+
+			Link(bridge, m);
+			Link(mPrev, m2);
+			Link(m2, bridge2);
+			Link(bridge2, bridgeNext);
+			return true;
+		}
+
+		bool IsEar(int ear) const
+		{
+			int a = nodes[ear].Prev;
+			int c = nodes[ear].Next;
+			if (Cross(a, ear, c) <= epsilon) return false;
+
+			for (int node = nodes[c].Next; node != a; node = nodes[node].Next)
+			{
+				if (SamePosition(node, a) || SamePosition(node, ear) || SamePosition(node, c)) continue;
+				if (InTriangle(a, ear, c, node)) return false;
+			}
+			return true;
+		}
+
+		void Emit(int a, int b, int c, std::vector<int>& indices) const
+		{
+			indices.push_back(nodes[a].Index);
+			indices.push_back(nodes[flip ? c : b].Index);
+			indices.push_back(nodes[flip ? b : c].Index);
+		}
+
+		bool ClipEars(int start, std::vector<int>& indices)
+		{
+			int remaining = 1;
+			for (int node = nodes[start].Next; node != start; node = nodes[node].Next)
+				remaining++;
+
+			int ear = start;
+			int stop = ear;
+			while (remaining > 3)
+			{
+				int next = nodes[ear].Next;
+				if (IsEar(ear))
+				{
+					Emit(nodes[ear].Prev, ear, next, indices);
+					Unlink(ear);
+					remaining--;
+					ear = stop = next;
+					continue;
+				}
+
+				ear = next;
+				if (ear != stop) continue;
+
+				// No ear left, drop one collinear or duplicate vertex and try again
+				bool removed = false;
+				int node = ear;
+				do
+				{
+					if (fabs(Cross(nodes[node].Prev, node, nodes[node].Next)) <= epsilon)
+					{
+						ear = stop = nodes[node].Next;
+						Unlink(node);
+						remaining--;
+						removed = true;
+						break;
+					}
+					node = nodes[node].Next;
+				} while (node != ear);
+
+				if (!removed) return false;
+			}
+
+			if (fabs(Cross(nodes[ear].Prev, ear, nodes[ear].Next)) > epsilon)
+				Emit(nodes[ear].Prev, ear, nodes[ear].Next, indices);
+			return true;
+		}
+	};
+
+	/// <summary>
+	/// Triangulates one face of a batch. Faces own disjoint point ranges, so faces can run in parallel.
+	/// </summary>
+	struct TriangulationKernel
+	{
+		const double* Points;
+		const int* RingOffsets;
+		const int* FaceRings;
+		std::vector<int>* Triangles;
+		double* Normals;
+
+		void operator()(int face) const
+		{
+			const int* offsets = &RingOffsets[FaceRings[face]];
+			int ringCount = FaceRings[face + 1] - FaceRings[face];
+			if (ringCount < 1) return;
+
+			double normal[3];
+			PolygonTriangulator::Newell(Points, offsets[0], offsets[1], normal);
+			double length = sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+			if (length > 0)
+				for (int i = 0; i < 3; i++) normal[i] /= length;
+
+			for (int i = offsets[0]; i < offsets[ringCount]; i++)
+				for (int j = 0; j < 3; j++) Normals[3 * i + j] = normal[j];
+
+			if (!PolygonTriangulator::Triangulate(Points, offsets, ringCount, Triangles[face]))
+				Triangles[face].clear();
+		}
+	};
+
+
+}
@@ -28,8 +28,10 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include <SketchUpAPI/model/model.h>
 #include <SketchUpAPI/model/entities.h>
 #include <SketchUpAPI/model/layer.h>
+#include <SketchUpAPI/model/entity.h>
 #include <msclr/marshal.h>
 #include <vector>
+#include <string>
 
 using namespace System;
 using namespace System::Collections;
@@ -37,10 +39,70 @@ using namespace System::Collections::Generic;
 
 namespace SketchUpNET
 {
+	typedef void (*ParallelKernel)(void* context, int index);
+
+	/// <summary>
+	/// Runs a native kernel on the thread pool, see Utilities::ParallelFor
+	/// </summary>
+	private ref class ParallelWorker
+	{
+	public:
+		ParallelWorker(ParallelKernel kernel, void* context)
+		{
+			this->kernel = kernel;
+			this->context = context;
+		};
+
+		void Run(int index)
+		{
+			kernel(context, index);
+		}
+
+		static void For(int count, ParallelKernel kernel, void* context)
+		{
+			if (count < 2)
+			{
+				for (int i = 0; i < count; i++)
+					kernel(context, i);
+				return;
+			}
+
+			ParallelWorker^ worker = gcnew ParallelWorker(kernel, context);
+			System::Threading::Tasks::Parallel::For(0, count, gcnew Action<int>(worker, &ParallelWorker::Run));
+		}
+
+	private:
+		ParallelKernel kernel;
+		void* context;
+	};
+
 	public class Utilities
 	{
 		public:
 
+		/// <summary>
+		/// Calls kernel(i) for i in [0, count) across threads. Kernels must only touch native data,
+		/// SketchUp API calls are not thread safe and stay on the calling thread.
+		/// </summary>
+		template <typename Kernel>
+		static void ParallelFor(int count, Kernel& kernel)
+		{
+			ParallelWorker::For(count, &Utilities::RunKernel<Kernel>, &kernel);
+		}
+
+		template <typename Kernel>
+		static void RunKernel(void* context, int index)
+		{
+			(*(Kernel*)context)(index);
+		}
+
+		static Int64 GetPersistentId(SUEntityRef entity)
+		{
+			int64_t pid = 0;
+			SUEntityGetPersistentID(entity, &pid);
+			return pid;
+		}
+
 		static System::String^ GetLayerName(SULayerRef layer)
 		{
 			SUStringRef layername = SU_INVALID;
@@ -76,6 +138,63 @@ namespace SketchUpNET
 			return result;
 		}
 
+		static std::string GetNativeString(SUStringRef name)
+		{
+			size_t name_length = 0;
+			SUStringGetUTF8Length(name, &name_length);
+			if (name_length == 0) return std::string();
+
+			std::vector<char> name_utf8(name_length + 1);
+			SUStringGetUTF8(name, name_length + 1, &name_utf8[0], &name_length);
+
+			return std::string(&name_utf8[0], name_length);
+		}
+
+		static System::String^ GetString(const std::string& name)
+		{
+			if (name.empty()) return System::String::Empty;
+
+			return gcnew System::String(name.c_str(), 0, (int)name.size(), System::Text::Encoding::UTF8);
+		}
+
+		static array<double>^ ToArray(const std::vector<double>& values)
+		{
+			array<double>^ result = gcnew array<double>((int)values.size());
+			if (!values.empty())
+				System::Runtime::InteropServices::Marshal::Copy(System::IntPtr((void*)&values[0]), result, 0, result->Length);
+			return result;
+		}
+
+		static array<int>^ ToArray(const std::vector<int>& values)
+		{
+			array<int>^ result = gcnew array<int>((int)values.size());
+			if (!values.empty())
+				System::Runtime::InteropServices::Marshal::Copy(System::IntPtr((void*)&values[0]), result, 0, result->Length);
+			return result;
+		}
+
+		static array<Int64>^ ToArray(const std::vector<int64_t>& values)
+		{
+			array<Int64>^ result = gcnew array<Int64>((int)values.size());
+			if (!values.empty())
+				System::Runtime::InteropServices::Marshal::Copy(System::IntPtr((void*)&values[0]), result, 0, result->Length);
+			return result;
+		}
+
+		static void FromArray(array<double>^ values, std::vector<double>& result)
+		{
+			result.resize(values == nullptr ? 0 : values->Length);
+			if (!result.empty())
+				System::Runtime::InteropServices::Marshal::Copy(values, 0, System::IntPtr(&result[0]), values->Length);
+		}
+
+		static void FromArray(array<int>^ values, std::vector<int>& result)
+		{
+			result.resize(values == nullptr ? 0 : values->Length);
+			if (!result.empty())
+				System::Runtime::InteropServices::Marshal::Copy(values, 0, System::IntPtr(&result[0]), values->Length);
+		}
+
 		
 
 
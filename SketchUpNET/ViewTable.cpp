@@ -0,0 +1,263 @@
+/*
+
+SketchUpNET - a C++ Wrapper for the Trimble(R) SketchUp(R) C API
+Copyright(C) 2015, Autor: Maximilian Thumfart
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+#pragma once
+
+#include <SketchUpAPI/slapi.h>
+#include <SketchUpAPI/geometry.h>
+#include <SketchUpAPI/initialize.h>
+#include <SketchUpAPI/model/model.h>
+#include <SketchUpAPI/model/scene.h>
+#include <SketchUpAPI/model/camera.h>
+#include <vector>
+#include "Utilities.h"
+#include "Camera.h"
+
+using namespace System;
+using namespace System::Collections;
+using namespace System::Collections::Generic;
+
+namespace SketchUpNET
+{
+	/// <summary>
+	/// Cameras of all scenes of a model as columns, one row per scene.
+	/// Points are stored as x,y,z triples in meters.
+	/// </summary>
+	public ref class ViewTable
+	{
+	public:
+		/// <summary>
+		/// Path of the file the views have been read from
+		/// </summary>
+		System::String^ File;
+
+		/// <summary>
+		/// Scene names
+		/// </summary>
+		array<String^>^ Names;
+
+		/// <summary>
+		/// Scene stores a camera, otherwise the camera is left unchanged when the scene is activated
+		/// </summary>
+		array<bool>^ UsesCamera;
+
+		/// <summary>
+		/// Eye positions in meters as x,y,z triplets
+		/// </summary>
+		array<double>^ Positions;
+
+		/// <summary>
+		/// Points the cameras look at in meters as x,y,z triplets
+		/// </summary>
+		array<double>^ Targets;
+
+		/// <summary>
+		/// Up directions as x,y,z triplets
+		/// </summary>
+		array<double>^ Ups;
+
+		/// <summary>
+		/// Perspective or parallel projection
+		/// </summary>
+		array<bool>^ Perspective;
+
+		/// <summary>
+		/// Field of view in degrees of perspective cameras
+		/// </summary>
+		array<double>^ FieldOfView;
+
+		/// <summary>
+		/// Field of view is measured vertically, otherwise horizontally
+		/// </summary>
+		array<bool>^ FieldOfViewIsHeight;
+
+		/// <summary>
+		/// Width to height ratio, 0 if the camera uses the aspect ratio of the viewport
+		/// </summary>
+		array<double>^ AspectRatio;
+
+		/// <summary>
+		/// View height in meters of parallel projection cameras
+		/// </summary>
+		array<double>^ OrthographicHeight;
+
+		/// <summary>
+		/// Near clipping distances in meters
+		/// </summary>
+		array<double>^ Near;
+
+		/// <summary>
+		/// Far clipping distances in meters
+		/// </summary>
+		array<double>^ Far;
+
+		/// <summary>
+		/// Row of the active scene or -1
+		/// </summary>
+		int ActiveScene;
+
+		property int Count
+		{
+			int get() { return (Names == nullptr) ? 0 : Names->Length; }
+		}
+
+		ViewTable(){};
+
+		/// <summary>
+		/// Returns the camera of a row
+		/// </summary>
+		SketchUpNET::Camera^ GetCamera(int row)
+		{
+			SketchUpNET::Camera^ camera = gcnew SketchUpNET::Camera(
+				gcnew Vertex(Positions[row * 3], Positions[row * 3 + 1], Positions[row * 3 + 2]),
+				gcnew Vertex(Targets[row * 3], Targets[row * 3 + 1], Targets[row * 3 + 2]),
+				gcnew Vector(Ups[row * 3], Ups[row * 3 + 1], Ups[row * 3 + 2]));
+
+			camera->Perspective = Perspective[row];
+			camera->FieldOfView = FieldOfView[row];
+			camera->FieldOfViewIsHeight = FieldOfViewIsHeight[row];
+			camera->AspectRatio = AspectRatio[row];
+			camera->OrthographicHeight = OrthographicHeight[row];
+			camera->Near = Near[row];
+			camera->Far = Far[row];
+			return camera;
+		}
+
+		/// <summary>
+		/// Reads the views of many files without extracting any geometry.
+		/// The API is initialized once for the whole batch, files which can't be opened yield null.
+		/// </summary>
+		/// <param name="filenames">Paths to .skp files</param>
+		static List<ViewTable^>^ FromFiles(IEnumerable<String^>^ filenames)
+		{
+			List<ViewTable^>^ tables = gcnew List<ViewTable^>();
+
+			SUInitialize();
+
+			for each (String^ filename in filenames)
+				tables->Add(FromFile(filename));
+
+			SUTerminate();
+			return tables;
+		}
+
+	internal:
+		/// <summary>
+		/// Stores a camera in a row, the inverse of GetCamera
+		/// </summary>
+		static void SetCamera(ViewTable^ table, int row, SketchUpNET::Camera^ camera)
+		{
+			table->Positions[row * 3] = camera->Position->X;
+			table->Positions[row * 3 + 1] = camera->Position->Y;
+			table->Positions[row * 3 + 2] = camera->Position->Z;
+			table->Targets[row * 3] = camera->Target->X;
+			table->Targets[row * 3 + 1] = camera->Target->Y;
+			table->Targets[row * 3 + 2] = camera->Target->Z;
+			table->Ups[row * 3] = camera->Up->X;
+			table->Ups[row * 3 + 1] = camera->Up->Y;
+			table->Ups[row * 3 + 2] = camera->Up->Z;
+
+			table->Perspective[row] = camera->Perspective;
+			table->FieldOfView[row] = camera->FieldOfView;
+			table->FieldOfViewIsHeight[row] = camera->FieldOfViewIsHeight;
+			table->AspectRatio[row] = camera->AspectRatio;
+			table->OrthographicHeight[row] = camera->OrthographicHeight;
+			table->Near[row] = camera->Near;
+			table->Far[row] = camera->Far;
+		}
+
+		/// <summary>
+		/// Opens, reads and releases a single file, expects the API to be initialized
+		/// </summary>
+		static ViewTable^ FromFile(String^ filename)
+		{
+			const char* path = Utilities::ToString(filename);
+			SUModelRef model = SU_INVALID;
+			SUModelLoadStatus status;
+			SUResult res = SUModelCreateFromFileWithStatus(&model, path, &status);
+			delete[] path;
+
+			if (res != SU_ERROR_NONE)
+				return nullptr;
+
+			ViewTable^ table = FromModel(model);
+			table->File = filename;
+
+			SUModelRelease(&model);
+			return table;
+		}
+
+		static ViewTable^ FromModel(SUModelRef model)
+		{
+			size_t count = 0;
+			SUModelGetNumScenes(model, &count);
+
+			std::vector<SUSceneRef> scenes(count);
+			if (count > 0)
+				SUModelGetScenes(model, count, &scenes[0], &count);
+
+			SUSceneRef active = SU_INVALID;
+			SUModelGetActiveScene(model, &active);
+
+			int n = (int)count;
+			ViewTable^ table = gcnew ViewTable();
+			table->Names = gcnew array<String^>(n);
+			table->UsesCamera = gcnew array<bool>(n);
+			table->Positions = gcnew array<double>(n * 3);
+			table->Targets = gcnew array<double>(n * 3);
+			table->Ups = gcnew array<double>(n * 3);
+			table->Perspective = gcnew array<bool>(n);
+			table->FieldOfView = gcnew array<double>(n);
+			table->FieldOfViewIsHeight = gcnew array<bool>(n);
+			table->AspectRatio = gcnew array<double>(n);
+			table->OrthographicHeight = gcnew array<double>(n);
+			table->Near = gcnew array<double>(n);
+			table->Far = gcnew array<double>(n);
+			table->ActiveScene = -1;
+
+			for (int i = 0; i < n; i++)
+			{
+				SUSceneRef scene = scenes[i];
+				if (SUIsValid(active) && scene.ptr == active.ptr)
+					table->ActiveScene = i;
+
+				SUStringRef name = SU_INVALID;
+				SUStringCreate(&name);
+				SUSceneGetName(scene, &name);
+				table->Names[i] = Utilities::GetString(name);
+				SUStringRelease(&name);
+
+				bool useCamera = true;
+				SUSceneGetUseCamera(scene, &useCamera);
+				table->UsesCamera[i] = useCamera;
+
+				SUCameraRef camera = SU_INVALID;
+				if (SUSceneGetCamera(scene, &camera) != SU_ERROR_NONE)
+					continue;
+
+				SetCamera(table, i, SketchUpNET::Camera::FromSU(camera));
+			}
+
+			return table;
+		}
+	};
+
+
+}
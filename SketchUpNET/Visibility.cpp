@@ -0,0 +1,176 @@
+/*
+
+SketchUpNET - a C++ Wrapper for the Trimble(R) SketchUp(R) C API
+Copyright(C) 2015, Autor: Maximilian Thumfart
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <SketchUpAPI/slapi.h>
+#include <SketchUpAPI/model/entity.h>
+#include <SketchUpAPI/model/drawing_element.h>
+#include <SketchUpAPI/model/layer.h>
+#include <SketchUpAPI/model/layer_folder.h>
+#include <SketchUpAPI/model/scene.h>
+#include <vector>
+
+using namespace System;
+using namespace System::Collections;
+using namespace System::Collections::Generic;
+
+namespace SketchUpNET
+{
+	/// <summary>
+	/// Decides which drawing elements are visible while a model is traversed, see LoadOptions::VisibleOnly.
+	/// Layer visibility including parent layer folders is evaluated once per layer.
+	/// Scenes may override the hidden layers, layer folders and root level entities of the model.
+	/// </summary>
+	private ref class VisibilityFilter
+	{
+	public:
+		VisibilityFilter()
+		{
+			this->layers = gcnew Dictionary<IntPtr, bool>();
+		};
+
+		/// <summary>
+		/// Creates a filter showing what a scene shows, root are the model's entities
+		/// </summary>
+		static VisibilityFilter^ FromScene(SUSceneRef scene, SUEntitiesRef root)
+		{
+			VisibilityFilter^ filter = gcnew VisibilityFilter();
+			filter->root = IntPtr(root.ptr);
+
+			bool useLayers = false;
+			SUSceneGetUseHiddenLayers(scene, &useLayers);
+			if (useLayers)
+			{
+				filter->hiddenLayers = gcnew HashSet<IntPtr>();
+				size_t count = 0;
+				SUSceneGetNumLayers(scene, &count);
+				if (count > 0)
+				{
+					std::vector<SULayerRef> layers(count);
+					SUSceneGetLayers(scene, count, &layers[0], &count);
+					for (size_t i = 0; i < count; i++)
+						filter->hiddenLayers->Add(IntPtr(layers[i].ptr));
+				}
+
+				filter->hiddenFolders = gcnew HashSet<IntPtr>();
+				count = 0;
+				SUSceneGetNumLayerFolders(scene, &count);
+				if (count > 0)
+				{
+					std::vector<SULayerFolderRef> folders(count);
+					SUSceneGetLayerFolders(scene, count, &folders[0], &count);
+					for (size_t i = 0; i < count; i++)
+						filter->hiddenFolders->Add(IntPtr(folders[i].ptr));
+				}
+			}
+
+			bool useGeometry = false, useObjects = false;
+			SUSceneGetUseHiddenGeometry(scene, &useGeometry);
+			SUSceneGetUseHiddenObjects(scene, &useObjects);
+			filter->sceneGeometry = useGeometry;
+			filter->sceneObjects = useObjects;
+			if (useGeometry || useObjects)
+			{
+				filter->hiddenEntities = gcnew HashSet<IntPtr>();
+				size_t count = 0;
+				SUSceneGetNumHiddenEntities(scene, &count);
+				if (count > 0)
+				{
+					std::vector<SUEntityRef> entities(count);
+					SUSceneGetHiddenEntities(scene, count, &entities[0], &count);
+					for (size_t i = 0; i < count; i++)
+						filter->hiddenEntities->Add(IntPtr(entities[i].ptr));
+				}
+			}
+
+			return filter;
+		}
+
+		bool IsVisible(SUDrawingElementRef element)
+		{
+			// Scenes remembering hidden geometry or objects replace the hidden flags of those at root level,
+			// nested elements keep their own flag
+			SURefType type = SUDrawingElementGetType(element);
+			bool isObject = type == SURefType_Group || type == SURefType_ComponentInstance;
+			bool hidden = false;
+			if ((isObject ? sceneObjects : sceneGeometry) && IsRoot(element))
+				hidden = hiddenEntities->Contains(IntPtr(SUDrawingElementToEntity(element).ptr));
+			else
+				SUDrawingElementGetHidden(element, &hidden);
+			if (hidden) return false;
+
+			SULayerRef layer = SU_INVALID;
+			SUDrawingElementGetLayer(element, &layer);
+			return SUIsInvalid(layer) || IsVisible(layer);
+		}
+
+		bool IsVisible(SULayerRef layer)
+		{
+			IntPtr key = IntPtr(layer.ptr);
+			bool visible = false;
+			if (layers->TryGetValue(key, visible))
+				return visible;
+
+			visible = true;
+			if (hiddenLayers != nullptr)
+				visible = !hiddenLayers->Contains(key);
+			else
+				SULayerGetVisibility(layer, &visible);
+
+			SULayerFolderRef folder = SU_INVALID;
+			if (visible && SULayerGetParentLayerFolder(layer, &folder) == SU_ERROR_NONE)
+			{
+				while (visible && !SUIsInvalid(folder))
+				{
+					if (hiddenFolders != nullptr)
+						visible = !hiddenFolders->Contains(IntPtr(folder.ptr));
+					else
+						SULayerFolderGetVisibility(folder, &visible);
+
+					SULayerFolderRef parent = SU_INVALID;
+					if (SULayerFolderGetParentLayerFolder(folder, &parent) != SU_ERROR_NONE) break;
+					folder = parent;
+				}
+			}
+
+			layers->Add(key, visible);
+			return visible;
+		}
+
+	private:
+		bool IsRoot(SUDrawingElementRef element)
+		{
+			SUEntitiesRef parent = SU_INVALID;
+			return SUEntityGetParentEntities(SUDrawingElementToEntity(element), &parent) == SU_ERROR_NONE && IntPtr(parent.ptr) == root;
+		}
+
+		Dictionary<IntPtr, bool>^ layers;
+		HashSet<IntPtr>^ hiddenLayers;
+		HashSet<IntPtr>^ hiddenFolders;
+		HashSet<IntPtr>^ hiddenEntities;
+		bool sceneGeometry;
+		bool sceneObjects;
+		IntPtr root;
+	};
+
+
+}